@@ -0,0 +1,209 @@
+// Benchmark for the lexical analyzer.
+// Scans a corpus built by repeating the given TruPL source files up to a target
+// size and reports the throughput of the best of several runs, for both
+// in-memory and stream buffers, for token objects, token values and batches
+// of token values, as well as for the parallel scanner.
+// Copyright 2016 Hieu Le.
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "scanner/memory_buffer.h"
+#include "scanner/parallel_scanner.h"
+#include "scanner/scanner.h"
+#include "scanner/stream_buffer.h"
+#include "tokens/token_stream.h"
+#include "tokens/token_value.h"
+#include "util/string_util.h"
+#include "util/text_colorizer.h"
+
+namespace truplc {
+namespace {
+
+// Default size of the scanned corpus, in megabytes.
+const int kDefaultMegabytes = 64;
+
+// Default number of timed runs per buffer type.
+const int kDefaultRuns = 5;
+
+// Number of tokens per batch when scanning into a token stream.
+const size_t kBatchSize = 4096;
+
+// Reads the whole content of a file.
+std::string ReadFile(const std::string& filename) {
+  std::ifstream file(filename, std::ios::binary);
+  if (!file) {
+    TextColorizer::Print(std::cerr, TextColorizer::kFGRedColorizer,
+                         StrCat("Error opening source file: ", filename, "\n"));
+    exit(EXIT_FAILURE);
+  }
+  std::ostringstream content;
+  content << file.rdbuf();
+  return content.str();
+}
+
+// Concatenates the given files, one after another on separate lines, until
+// the result reaches a given size.
+std::string BuildCorpus(const std::vector<std::string>& filenames,
+                        const size_t size) {
+  std::string sources;
+  for (const std::string& filename : filenames) {
+    sources += ReadFile(filename);
+    sources += '\n';
+  }
+  std::string corpus;
+  corpus.reserve(size + sources.size());
+  while (corpus.size() < size) {
+    corpus += sources;
+  }
+  return corpus;
+}
+
+// Scans every token produced by a scanner as a token object. Returns the
+// number of tokens, including the final EOF token.
+size_t ScanTokens(Scanner* scanner) {
+  size_t count = 0;
+  TokenHandle token;
+  do {
+    token = scanner->NextToken();
+    ++count;
+  } while (token->GetTokenType() != TokenType::kEOF);
+  return count;
+}
+
+// Scans every token produced by a scanner as a token value. Returns the
+// number of tokens, including the final EOF token.
+size_t ScanValues(Scanner* scanner) {
+  size_t count = 0;
+  TokenValue value;
+  do {
+    value = scanner->NextTokenValue();
+    ++count;
+  } while (value.type != TokenType::kEOF);
+  return count;
+}
+
+// Scans every token produced by a scanner in batches of a token stream.
+// Returns the number of tokens, including the final EOF token.
+size_t ScanBatches(Scanner* scanner) {
+  size_t count = 0;
+  TokenStream stream;
+  stream.reserve(kBatchSize);
+  do {
+    stream.clear();
+    count += scanner->TokenizeInto(&stream, kBatchSize);
+  } while (stream.type(stream.size() - 1) != TokenType::kEOF);
+  return count;
+}
+
+// Prints the throughput of a scan of a corpus.
+void PrintResult(const std::string& name, const std::string& corpus,
+                 const size_t tokens, const double seconds) {
+  std::cout << Format("%-15s %10zu tokens  %8.3f s  %7.2f Mtokens/s  "
+                      "%8.1f MB/s\n",
+                      name.c_str(), tokens, seconds, tokens / seconds / 1e6,
+                      corpus.size() / seconds / (1 << 20));
+}
+
+// Times the scan of a corpus through buffers created by a factory and prints
+// the throughput of the fastest run.
+template <typename BufferFactory>
+void Run(const std::string& name, const std::string& corpus, const int runs,
+         BufferFactory create_buffer, size_t (*scan)(Scanner*)) {
+  double best_seconds = 0;
+  size_t tokens = 0;
+  for (int run = 0; run < runs; ++run) {
+    const auto start = std::chrono::steady_clock::now();
+    Scanner scanner(create_buffer());
+    tokens = scan(&scanner);
+    const std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    if (run == 0 || elapsed.count() < best_seconds) {
+      best_seconds = elapsed.count();
+    }
+  }
+  PrintResult(name, corpus, tokens, best_seconds);
+}
+
+// Times the tokenization of a corpus by ParallelScanner on a given number of
+// threads and prints the throughput of the fastest run.
+void RunParallel(const std::string& name, const std::string& corpus,
+                 const int runs, const int threads) {
+  double best_seconds = 0;
+  size_t tokens = 0;
+  for (int run = 0; run < runs; ++run) {
+    const auto start = std::chrono::steady_clock::now();
+    ParallelScanner scanner(corpus.data(), corpus.size(), threads);
+    tokens = scanner.values().size();
+    const std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    if (run == 0 || elapsed.count() < best_seconds) {
+      best_seconds = elapsed.count();
+    }
+  }
+  PrintResult(name, corpus, tokens, best_seconds);
+}
+
+}  // namespace
+}  // namespace truplc
+
+int main(int argc, char** argv) {
+  int megabytes = truplc::kDefaultMegabytes;
+  int runs = truplc::kDefaultRuns;
+  int threads = 0;
+  std::vector<std::string> filenames;
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    if (arg.compare(0, 12, "--megabytes=") == 0) {
+      megabytes = std::atoi(arg.c_str() + 12);
+    } else if (arg.compare(0, 7, "--runs=") == 0) {
+      runs = std::atoi(arg.c_str() + 7);
+    } else if (arg.compare(0, 10, "--threads=") == 0) {
+      threads = std::atoi(arg.c_str() + 10);
+    } else {
+      filenames.push_back(arg);
+    }
+  }
+  if (filenames.empty() || megabytes <= 0 || runs <= 0 || threads < 0) {
+    truplc::TextColorizer::Print(
+        std::cerr, truplc::TextColorizer::kFGRedColorizer,
+        truplc::StrCat("Usage: ", argv[0],
+                       " [--megabytes=N] [--runs=N] [--threads=N]"
+                       " <input file name>...\n"));
+    exit(EXIT_FAILURE);
+  }
+
+  const std::string corpus =
+      truplc::BuildCorpus(filenames, static_cast<size_t>(megabytes) << 20);
+  std::cout << truplc::Format("Corpus: %zu bytes from %zu files\n",
+                              corpus.size(), filenames.size());
+
+  const auto memory_buffer = [&corpus] {
+    return std::make_unique<truplc::MemoryBuffer>(corpus.data(),
+                                                  corpus.size());
+  };
+  std::istringstream stream;
+  const auto stream_buffer = [&corpus, &stream] {
+    stream.clear();
+    stream.str(corpus);
+    return std::make_unique<truplc::StreamBuffer>(&stream);
+  };
+  truplc::Run("memory", corpus, runs, memory_buffer, truplc::ScanTokens);
+  truplc::Run("stream", corpus, runs, stream_buffer, truplc::ScanTokens);
+  truplc::Run("memory/values", corpus, runs, memory_buffer,
+              truplc::ScanValues);
+  truplc::Run("stream/values", corpus, runs, stream_buffer,
+              truplc::ScanValues);
+  truplc::Run("memory/batches", corpus, runs, memory_buffer,
+              truplc::ScanBatches);
+  truplc::Run("stream/batches", corpus, runs, stream_buffer,
+              truplc::ScanBatches);
+  truplc::RunParallel("parallel/values", corpus, runs, threads);
+  return 0;
+}
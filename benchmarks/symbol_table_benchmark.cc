@@ -0,0 +1,133 @@
+// Benchmark for the symbol table.
+// Installs generated declarations, spread over procedures with numbered
+// formal parameters, into tables of growing sizes and reports the time per
+// install and per lookup. Lookups should take the same time at every size.
+// Copyright 2016 Hieu Le.
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "parser/symbol_table.h"
+#include "util/string_interner.h"
+#include "util/string_util.h"
+#include "util/text_colorizer.h"
+
+namespace truplc {
+namespace {
+
+// Default numbers of declarations installed into the table.
+const std::vector<size_t> kDefaultSizes = {100000, 300000, 1000000};
+
+// Default number of lookups of each kind per table.
+const size_t kDefaultLookups = 1000000;
+
+// Number of formal parameters of each generated procedure.
+const int kParametersPerProcedure = 8;
+
+// Returns the seconds elapsed since a given time.
+double SecondsSince(const std::chrono::steady_clock::time_point start) {
+  const std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  return elapsed.count();
+}
+
+// Times the installation of a given number of declarations and lookups of
+// random ones, and prints the time per operation.
+void Run(const size_t size, const size_t lookups) {
+  // Names are interned up front so that only the table is timed.
+  StringInterner interner;
+  std::vector<StringInterner::Id> identifiers(size);
+  std::vector<StringInterner::Id> environments(size);
+  for (size_t i = 0; i < size; ++i) {
+    identifiers[i] = interner.Intern(StrCat("v", std::to_string(i)));
+    environments[i] = interner.Intern(
+        StrCat("main::p", std::to_string(i / kParametersPerProcedure)));
+  }
+
+  SymbolTable table(&interner);
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < size; ++i) {
+    table.Install(identifiers[i], environments[i], ExpressionType::kInt,
+                  static_cast<int>(i % kParametersPerProcedure));
+  }
+  const double install_seconds = SecondsSince(start);
+
+  std::mt19937 random(42);
+  std::uniform_int_distribution<size_t> pick(0, size - 1);
+  std::vector<size_t> picks(lookups);
+  for (size_t& i : picks) {
+    i = pick(random);
+  }
+
+  size_t found = 0;
+  start = std::chrono::steady_clock::now();
+  for (const size_t i : picks) {
+    found += table.IsDeclared(identifiers[i], environments[i]);
+  }
+  const double declared_seconds = SecondsSince(start);
+
+  start = std::chrono::steady_clock::now();
+  for (const size_t i : picks) {
+    found += table.GetType(identifiers[i], environments[i]) ==
+             ExpressionType::kInt;
+  }
+  const double type_seconds = SecondsSince(start);
+
+  start = std::chrono::steady_clock::now();
+  for (const size_t i : picks) {
+    found += table.GetType(environments[i],
+                           static_cast<int>(i % kParametersPerProcedure)) ==
+             ExpressionType::kInt;
+  }
+  const double position_seconds = SecondsSince(start);
+
+  if (found != 3 * lookups) {
+    TextColorizer::Print(std::cerr, TextColorizer::kFGRedColorizer,
+                         "Lookup failed\n");
+    exit(EXIT_FAILURE);
+  }
+  std::cout << Format("%8zu declarations  install %6.1f ns  "
+                      "IsDeclared %6.1f ns  GetType %6.1f ns  "
+                      "GetType(position) %6.1f ns\n",
+                      size, install_seconds / size * 1e9,
+                      declared_seconds / lookups * 1e9,
+                      type_seconds / lookups * 1e9,
+                      position_seconds / lookups * 1e9);
+}
+
+}  // namespace
+}  // namespace truplc
+
+int main(int argc, char** argv) {
+  size_t lookups = truplc::kDefaultLookups;
+  std::vector<size_t> sizes;
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    if (arg.compare(0, 10, "--lookups=") == 0) {
+      lookups = std::strtoul(arg.c_str() + 10, nullptr, 10);
+    } else {
+      sizes.push_back(std::strtoul(arg.c_str(), nullptr, 10));
+    }
+  }
+  if (sizes.empty()) {
+    sizes = truplc::kDefaultSizes;
+  }
+  for (const size_t size : sizes) {
+    if (size == 0 || lookups == 0) {
+      truplc::TextColorizer::Print(
+          std::cerr, truplc::TextColorizer::kFGRedColorizer,
+          truplc::StrCat("Usage: ", argv[0],
+                         " [--lookups=N] [declarations]...\n"));
+      exit(EXIT_FAILURE);
+    }
+  }
+
+  for (const size_t size : sizes) {
+    truplc::Run(size, lookups);
+  }
+  return 0;
+}
@@ -1,42 +1,338 @@
 // Driver program for Scanner class.
-// Prints all TruPL tokens and their attributes from a source file.
+// Prints all TruPL tokens and their attributes from a source file, as text,
+// JSON or binary records, through one large output buffer. With
+// --token_cache=<dir>, the tokens of an unchanged regular file are replayed
+// from a cache file written by an earlier run instead of being scanned again.
+// With --stats, counters on the scan and its throughput are printed to the
+// standard error at the end.
 // Copyright 2016 Hieu Le.
 
+#include <unistd.h>
+
+#include <cinttypes>
+#include <cstdint>
 #include <cstdlib>
 
+#include <chrono>
 #include <iostream>
+#include <string>
 
+#include "scanner/scan_stats.h"
 #include "scanner/scanner.h"
+#include "scanner/token_cache.h"
+#include "util/buffered_writer.h"
+#include "util/mapped_file.h"
 #include "util/string_util.h"
 #include "util/text_colorizer.h"
 
-int main(int argc, char** argv) {
-  char *filename;
-  if (argc != 2) {
-    truplc::TextColorizer::Print(
-        std::cerr, truplc::TextColorizer::kFGRedColorizer,
-        truplc::StrCat("Usage: ", argv[0], " <input file name>\n"));
-    exit(EXIT_FAILURE);
+namespace truplc {
+namespace {
+
+// Output formats of the driver.
+enum class OutputFormat {
+  kText,    // One debug string per line, e.g. "kKeyword:kProgram".
+  kJson,    // An array with one object per token.
+  kBinary,  // One TokenValue per token, as 16 bytes in native byte order.
+};
+
+// Writes scanned tokens to an output buffer in a given format.
+class TokenWriter {
+ public:
+  // Constructs a writer to a given buffer, which must outlive the writer.
+  // Text is colored if color is true. If quiet is true, tokens are only
+  // counted.
+  TokenWriter(OutputFormat format, bool color, bool quiet,
+              BufferedWriter* out);
+
+  // Writes a token scanned from a given lexeme. number is the value of a
+  // number token. Identifier attributes are ids of names in interner.
+  void Write(const TokenValue& value, StringPiece lexeme, int64_t number,
+             const StringInterner& interner);
+
+  // Completes the output once all tokens have been written, and flushes it.
+  // Returns false if any of the output could not be written.
+  bool Finish();
+
+ private:
+  // Writes a token in each format.
+  void WriteText(const TokenValue& value, StringPiece lexeme, int64_t number,
+                 const StringInterner& interner);
+  void WriteJson(const TokenValue& value, StringPiece lexeme);
+
+  // Appends a string as a quoted JSON string.
+  void AppendJsonString(StringPiece str);
+
+  const OutputFormat format_;
+  const bool color_;
+  const bool quiet_;
+  BufferedWriter* const out_;
+
+  // Number of tokens written.
+  size_t count_;
+};
+
+TokenWriter::TokenWriter(const OutputFormat format, const bool color,
+                         const bool quiet, BufferedWriter* const out)
+    : format_(format), color_(color), quiet_(quiet), out_(out), count_(0) {}
+
+void TokenWriter::Write(const TokenValue& value, const StringPiece lexeme,
+                        const int64_t number,
+                        const StringInterner& interner) {
+  ++count_;
+  if (quiet_) {
+    return;
+  }
+  switch (format_) {
+    case OutputFormat::kText:
+      WriteText(value, lexeme, number, interner);
+      break;
+    case OutputFormat::kJson:
+      WriteJson(value, lexeme);
+      break;
+    case OutputFormat::kBinary:
+      out_->Append(reinterpret_cast<const char*>(&value), sizeof(value));
+      break;
   }
+}
 
-  filename = argv[1];
+void TokenWriter::WriteText(const TokenValue& value, const StringPiece lexeme,
+                            const int64_t number,
+                            const StringInterner& interner) {
+  // The token is only used right away, so it may refer to the lexeme.
+  const TokenHandle token =
+      internal::NewToken(value, lexeme, number, true, &interner);
+  if (!token) {
+    TextColorizer::Print(std::cerr, TextColorizer::kFGRedColorizer,
+                         "Error: NextToken() returned typeless token.\n");
+  } else {
+    if (color_) {
+      TextColorizer::kFGGreenColorizer.AppendColor(out_);
+    }
+    token->AppendDebugString(out_);
+    out_->Append('\n');
+    if (color_) {
+      TextColorizer::AppendReset(out_);
+    }
+  }
+}
 
-  // Declare a scanner object and a pointer to a Token object.
-  truplc::Scanner scanner(filename);
-  std::unique_ptr<truplc::Token> token;
+void TokenWriter::WriteJson(const TokenValue& value,
+                            const StringPiece lexeme) {
+  out_->Append(count_ == 1 ? "[\n{\"type\":\"" : ",\n{\"type\":\"");
+  out_->Append(TokenTypeName(value.type));
+  out_->Append("\",\"attribute\":");
+  out_->AppendDecimal(value.attribute);
+  out_->Append(",\"offset\":");
+  out_->AppendDecimal(value.offset);
+  out_->Append(",\"length\":");
+  out_->AppendDecimal(value.length);
+  out_->Append(",\"lexeme\":");
+  AppendJsonString(lexeme);
+  out_->Append('}');
+}
 
+void TokenWriter::AppendJsonString(const StringPiece str) {
+  static const char kHexDigits[] = "0123456789abcdef";
+  out_->Append('"');
+  for (const char c : str) {
+    const unsigned char byte = static_cast<unsigned char>(c);
+    if (c == '"' || c == '\\') {
+      out_->Append('\\');
+      out_->Append(c);
+    } else if (byte < 0x20) {
+      out_->Append("\\u00");
+      out_->Append(kHexDigits[byte >> 4]);
+      out_->Append(kHexDigits[byte & 0xF]);
+    } else {
+      out_->Append(c);
+    }
+  }
+  out_->Append('"');
+}
+
+bool TokenWriter::Finish() {
+  if (quiet_) {
+    out_->AppendDecimal(static_cast<int64_t>(count_));
+    out_->Append(" tokens\n");
+  } else if (format_ == OutputFormat::kJson) {
+    out_->Append(count_ == 0 ? "[]\n" : "\n]\n");
+  }
+  return out_->Flush();
+}
+
+// Scans all tokens of a file and writes them. Statistics on the scan are
+// collected into stats unless it is null.
+void WriteTokens(const std::string& filename, TokenWriter* writer,
+                 ScanStats* stats) {
+  Scanner scanner(filename);
+  if (stats != nullptr) {
+    scanner.EnableStats();
+  }
+  TokenValue value;
   do {
-    token = scanner.NextToken();
-    if (token->GetTokenType() == truplc::TokenType::kUnspecified) {
-      truplc::TextColorizer::Print(
-          std::cerr, truplc::TextColorizer::kFGRedColorizer,
-          "Error: NextToken() returned typeless token.\n");
+    value = scanner.NextTokenValue();
+    writer->Write(value, scanner.Lexeme(), scanner.NumberValue(),
+                  *scanner.interner());
+  } while (value.type != TokenType::kEOF);
+  if (stats != nullptr) {
+    *stats = scanner.stats();
+  }
+}
+
+// Writes all tokens of a regular file, replaying them from a cache when
+// possible and caching them otherwise. Statistics are collected into stats
+// unless it is null; replayed tokens are counted as if they were scanned,
+// but no characters are put back when replaying.
+// Returns false if the file cannot be mapped.
+bool WriteCachedTokens(const std::string& filename, TokenCache* cache,
+                       TokenWriter* writer, ScanStats* stats) {
+  MappedFile source;
+  if (!IsRegularFile(filename) || !source.Open(filename)) {
+    return false;
+  }
+  const StringPiece text(source.data(), source.size());
+  TokenStream stream;
+  StringInterner interner;
+  if (cache->Lookup(text, &stream, &interner)) {
+    size_t k = 0;
+    for (size_t i = 0; i < stream.size(); ++i) {
+      const TokenValue value = stream[i];
+      if (stats != nullptr) {
+        stats->Count(value);
+      }
+      const int64_t number =
+          value.type == TokenType::kNumber ? stream.number(k++) : 0;
+      writer->Write(value,
+                    StringPiece(text.data() + value.offset, value.length),
+                    number, interner);
+    }
+    return true;
+  }
+
+  // Tokens are written as they are scanned, so that those preceding a
+  // lexical error still show up.
+  Scanner scanner(text.data(), text.size());
+  if (stats != nullptr) {
+    scanner.EnableStats();
+  }
+  TokenValue value;
+  do {
+    value = scanner.NextTokenValue();
+    stream.push_back(value, scanner.NumberValue());
+    writer->Write(value, scanner.Lexeme(), scanner.NumberValue(),
+                  *scanner.interner());
+  } while (value.type != TokenType::kEOF);
+  if (stats != nullptr) {
+    *stats = scanner.stats();
+  }
+  if (!cache->Store(text, stream, *scanner.interner())) {
+    TextColorizer::Print(std::cerr, TextColorizer::kFGRedColorizer,
+                         StrCat("Warning: cannot write ",
+                                cache->PathFor(text), "\n"));
+  }
+  return true;
+}
+
+// Prints statistics on a scan that took a given number of seconds, including
+// the time spent writing the tokens.
+void PrintStats(const ScanStats& stats, const double seconds) {
+  std::cerr << Format("Bytes read:      %12" PRIu64 "\n"
+                      "Bytes skipped:   %12" PRIu64 "\n"
+                      "Buffer refills:  %12" PRIu64 "\n"
+                      "Pushbacks:       %12" PRIu64 "\n"
+                      "Tokens:          %12" PRIu64 "\n",
+                      stats.bytes_read(), stats.skipped_bytes(),
+                      stats.refills(), stats.pushbacks(),
+                      stats.total_tokens());
+  for (size_t i = 0; i < ScanStats::kNumTokenTypes; ++i) {
+    const TokenType type = static_cast<TokenType>(i);
+    std::cerr << Format("  %-14s %12" PRIu64 "\n", TokenTypeName(type),
+                        stats.tokens(type));
+  }
+  // An empty input may be scanned faster than the clock resolution.
+  const double rate_seconds = seconds > 0 ? seconds : 1e-9;
+  std::cerr << Format("Wall time:       %12.6f s\n"
+                      "Throughput:      %12.2f MB/s\n"
+                      "                 %12.0f tokens/s\n",
+                      seconds,
+                      stats.bytes_read() / rate_seconds / (1 << 20),
+                      stats.total_tokens() / rate_seconds);
+}
+
+}  // namespace
+}  // namespace truplc
+
+int main(int argc, char** argv) {
+  truplc::OutputFormat format = truplc::OutputFormat::kText;
+  bool quiet = false;
+  bool print_stats = false;
+  std::string cache_directory;
+  std::string filename;
+  bool valid = true;
+  for (int i = 1; i < argc && valid; ++i) {
+    const std::string arg = argv[i];
+    if (arg == "--format=text") {
+      format = truplc::OutputFormat::kText;
+    } else if (arg == "--format=json") {
+      format = truplc::OutputFormat::kJson;
+    } else if (arg == "--format=binary") {
+      format = truplc::OutputFormat::kBinary;
+    } else if (arg == "--quiet") {
+      quiet = true;
+    } else if (arg == "--stats") {
+      print_stats = true;
+    } else if (arg.compare(0, 14, "--token_cache=") == 0) {
+      cache_directory = arg.substr(14);
+    } else if (filename.empty() && arg.compare(0, 2, "--") != 0) {
+      filename = arg;
     } else {
-      truplc::TextColorizer::Print(
-          std::cout, truplc::TextColorizer::kFGGreenColorizer,
-          truplc::StrCat(token->DebugString(), "\n"));
+      valid = false;
     }
-  } while (token->GetTokenType() != truplc::TokenType::kEOF);
+  }
+  if (!valid || filename.empty()) {
+    truplc::TextColorizer::Print(
+        std::cerr, truplc::TextColorizer::kFGRedColorizer,
+        truplc::StrCat("Usage: ", argv[0],
+                       " [--format=text|json|binary] [--quiet] [--stats]"
+                       " [--token_cache=<dir>] <input file name>\n"));
+    exit(EXIT_FAILURE);
+  }
 
+  // Standard output is backed by the buffer, so that diagnostics printed to
+  // the standard error, which is tied to it, follow the tokens preceding them.
+  truplc::BufferedWriter out(STDOUT_FILENO);
+  std::streambuf* const stdout_buffer = std::cout.rdbuf(&out);
+  truplc::TokenWriter writer(format, isatty(STDOUT_FILENO) != 0, quiet, &out);
+
+  truplc::ScanStats stats;
+  truplc::ScanStats* const stats_or_null = print_stats ? &stats : nullptr;
+  const auto start = std::chrono::steady_clock::now();
+  bool written;
+  if (cache_directory.empty()) {
+    truplc::WriteTokens(filename, &writer, stats_or_null);
+    written = writer.Finish();
+  } else {
+    // Streams, such as pipes, cannot be hashed before they are scanned and
+    // are never cached.
+    truplc::TokenCache cache(cache_directory);
+    if (!truplc::WriteCachedTokens(filename, &cache, &writer, stats_or_null)) {
+      truplc::WriteTokens(filename, &writer, stats_or_null);
+    }
+    written = writer.Finish();
+    std::cerr << truplc::Format("Token cache: %zu hits, %zu misses\n",
+                                cache.hits(), cache.misses());
+  }
+  if (print_stats) {
+    const std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    truplc::PrintStats(stats, elapsed.count());
+  }
+  std::cout.rdbuf(stdout_buffer);
+  if (!written) {
+    truplc::TextColorizer::Print(
+        std::cerr, truplc::TextColorizer::kFGRedColorizer,
+        "Error: cannot write the tokens to the standard output.\n");
+    return EXIT_FAILURE;
+  }
   return 0;
 }
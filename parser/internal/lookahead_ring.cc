@@ -0,0 +1,76 @@
+// Implementation for LookaheadRing class.
+// Copyright 2016 Hieu Le.
+
+#include "parser/internal/lookahead_ring.h"
+
+#include <algorithm>
+#include <string>
+
+#include "scanner/basic_scanner.h"
+
+namespace truplc {
+namespace internal {
+
+LookaheadRing::LookaheadRing(Scanner* const scanner)
+    : scanner_(scanner), numbers_(), head_(0), size_(0) {
+  Refill();
+}
+
+void LookaheadRing::Refill() {
+  // The batch stops after the EOF token, so the ring never holds more than
+  // one even though the scanner keeps returning it past the end of input.
+  batch_.clear();
+  scanner_->TokenizeInto(&batch_, kCapacity - size_);
+  size_t k = 0;
+  for (size_t i = 0; i < batch_.size(); ++i, ++size_) {
+    const size_t slot = Slot(size_);
+    values_[slot] = batch_[i];
+    if (batch_.type(i) == TokenType::kNumber) {
+      numbers_[slot] = batch_.number(k++);
+    }
+  }
+}
+
+TokenValue LookaheadRing::Peek(const size_t k) {
+  if (k >= size_) {
+    if (values_[Slot(size_ - 1)].type == TokenType::kEOF) {
+      return values_[Slot(size_ - 1)];
+    }
+    Refill();
+    // The batch stops after the EOF token, which may come before k.
+    return values_[Slot(std::min(k, size_ - 1))];
+  }
+  return values_[Slot(k)];
+}
+
+void LookaheadRing::Consume() {
+  if (size_ == 1) {
+    // Keep the EOF token around once reached.
+    if (values_[head_].type == TokenType::kEOF) {
+      return;
+    }
+    head_ = Slot(1);
+    size_ = 0;
+    Refill();
+    return;
+  }
+  head_ = Slot(1);
+  --size_;
+}
+
+TokenHandle LookaheadRing::NewToken(const size_t k) {
+  const TokenValue value = Peek(k);
+  const size_t slot = Slot(k < size_ ? k : size_ - 1);
+  std::string lexeme;
+  if (value.type == TokenType::kNumber) {
+    lexeme = std::to_string(numbers_[slot]);
+    if (lexeme.size() < value.length) {
+      lexeme.insert(0, value.length - lexeme.size(), '0');
+    }
+  }
+  return internal::NewToken(value, lexeme, numbers_[slot], false,
+                            scanner_->interner());
+}
+
+}  // namespace internal
+}  // namespace truplc
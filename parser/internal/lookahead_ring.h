@@ -0,0 +1,79 @@
+// Window of upcoming tokens in front of a Scanner. Tokens are scanned in
+// batches into a fixed ring of token values, from which the parser peeks
+// at any of the next few tokens and consumes them one at a time.
+// Copyright 2016 Hieu Le.
+
+#ifndef TRUPLC_PARSER_INTERNAL_LOOKAHEAD_RING_H__
+#define TRUPLC_PARSER_INTERNAL_LOOKAHEAD_RING_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "scanner/scanner.h"
+#include "tokens/token.h"
+#include "tokens/token_handle.h"
+#include "tokens/token_stream.h"
+#include "tokens/token_value.h"
+#include "util/string_piece.h"
+
+namespace truplc {
+namespace internal {
+
+class LookaheadRing {
+ public:
+  // Number of tokens the ring holds. Peek() looks at most this many tokens
+  // ahead.
+  static const size_t kCapacity = 32;
+
+  // Constructs a ring in front of a given scanner, which must outlive the
+  // ring, and scans the first batch of tokens.
+  explicit LookaheadRing(Scanner* scanner);
+
+  // Returns the current token, i.e. the next one to be consumed.
+  TokenValue Current() const { return values_[head_]; }
+
+  // Returns the token k positions after the current one; Peek(0) is the
+  // current token. k must be less than kCapacity. Past the end of input, the
+  // EOF token is returned.
+  TokenValue Peek(size_t k);
+
+  // Drops the current token and moves on to the next one.
+  void Consume();
+
+  // Creates the token object for the token k positions after the current
+  // one. Intended for diagnostics.
+  TokenHandle NewToken(size_t k = 0);
+
+ private:
+  // Scans tokens into all free slots of the ring, in one batch.
+  void Refill();
+
+  // Index of the slot k positions after the head.
+  size_t Slot(const size_t k) const { return (head_ + k) % kCapacity; }
+
+  // The scanner tokens are read from.
+  Scanner* const scanner_;
+
+  // Batch of tokens last scanned, reused across refills.
+  TokenStream batch_;
+
+  // Scanned tokens, in order from the head.
+  TokenValue values_[kCapacity];
+
+  // Values of the scanned number tokens, as converted by the scanner. Their
+  // lexemes are the digits of the value, padded with leading zeros to the
+  // length of the token, so they need not be kept.
+  int64_t numbers_[kCapacity];
+
+  // Slot of the current token.
+  size_t head_;
+
+  // Number of scanned tokens in the ring. At least one.
+  size_t size_;
+};
+
+}  // namespace internal
+}  // namespace truplc
+
+#endif  // TRUPLC_PARSER_INTERNAL_LOOKAHEAD_RING_H__
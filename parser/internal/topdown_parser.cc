@@ -6,12 +6,11 @@
 #include <utility>
 
 #include "tokens/add_operator_token.h"
-#include "tokens/identifier_token.h"
 #include "tokens/keyword_token.h"
 #include "tokens/mul_operator_token.h"
-#include "tokens/number_token.h"
 #include "tokens/punctuation_token.h"
 #include "tokens/rel_operator_token.h"
+#include "util/sink.h"
 #include "util/string_util.h"
 
 namespace truplc {
@@ -26,19 +25,21 @@ static const char kDefaultEnvName[] = "__UNDEFINED";
 
 TopdownParser::TopdownParser(std::unique_ptr<Scanner> scanner)
     : scanner_(std::move(scanner)),
-      word_(scanner_->NextToken()),
-      current_env_(kDefaultEnvName),
-      main_env_(kDefaultEnvName),
-      procedure_name_(kDefaultEnvName),
-      parsing_formal_parm_list_(false) {}
+      interner_(scanner_->interner()),
+      lookahead_(scanner_.get()),
+      current_env_(interner_->Intern(std::string(kDefaultEnvName))),
+      main_env_(current_env_),
+      procedure_name_(current_env_),
+      parsing_formal_parm_list_(false),
+      symtable_(interner_) {}
 
 bool TopdownParser::HasNextToken() const {
   // If we have parsed the entire program, then word should be EOF.
-  return word_->GetTokenType() == TokenType::kEOF;
+  return word().type == TokenType::kEOF;
 }
 
 void TopdownParser::Advance() {
-  word_ = scanner_->NextToken();
+  lookahead_.Consume();
 }
 
 namespace {
@@ -53,22 +54,35 @@ void PrintError(const std::string& message, bool crash) {
 
 }  // namespace
 
-void TopdownParser::ReportSyntaxError(const std::string& expected,
-                                      const Token& actual) const {
-  PrintError(Format("Syntax error: Expected: %s Actual: %s.",
-                    expected.c_str(), actual.DebugString().c_str()), false);
+std::string TopdownParser::DescribeLocation() const {
+  const SourceManager* source_manager = scanner_->source_manager();
+  if (source_manager == nullptr) {
+    return std::string();
+  }
+  return source_manager->Describe(word().offset);
+}
+
+void TopdownParser::ReportSyntaxError(const std::string& expected) {
+  std::string message = Format("Syntax error%s: Expected: %s Actual: ",
+                               DescribeLocation().c_str(), expected.c_str());
+  StringSink sink(&message);
+  lookahead_.NewToken()->AppendDebugString(&sink);
+  message += '.';
+  PrintError(message, false);
 }
 
 void TopdownParser::ReportMultiplyDefinedIdentifier(
-    const std::string& identifier) const {
-  PrintError(Format("Semantic error: The identifier '%s' has been declared.",
-                    identifier.c_str()), true);
+    const StringInterner::Id identifier) const {
+  PrintError(Format("Semantic error%s: The identifier '%s' has been "
+                    "declared.", DescribeLocation().c_str(),
+                    interner_->Lookup(identifier).ToString().c_str()), true);
 }
 
 void TopdownParser::ReportUndeclaredIdentifier(
-    const std::string& identifier) const {
-  PrintError(Format("Semantic error: The identifier '%s' has already been "
-                    "declared.", identifier.c_str()), true);
+    const StringInterner::Id identifier) const {
+  PrintError(Format("Semantic error%s: The identifier '%s' has already been "
+                    "declared.", DescribeLocation().c_str(),
+                    interner_->Lookup(identifier).ToString().c_str()), true);
 }
 
 void TopdownParser::ReportTypeError(const ExpressionType expected,
@@ -92,73 +106,78 @@ namespace {
 // Functions for querying the type of a token.
 
 // Checks if a given token is an identifier.
-inline bool IsIdentifier(const Token& token) {
-  return token.GetTokenType() == TokenType::kIdentifier;
+inline bool IsIdentifier(const TokenValue& token) {
+  return token.type == TokenType::kIdentifier;
 }
 
 // Checks if a given token is a keyword with the specified attribute.
-inline bool IsKeyword(const Token& token, const KeywordAttribute attr) {
-  return token.GetTokenType() == TokenType::kKeyword
-      && static_cast<const KeywordToken&>(token).GetAttribute() == attr;
+inline bool IsKeyword(const TokenValue& token, const KeywordAttribute attr) {
+  return token.type == TokenType::kKeyword
+      && token.attribute == static_cast<int>(attr);
 }
 
 // Checks if a given token is a punctuation with the specified attribute.
-inline bool IsPunctuation(const Token& token, const PunctuationAttribute attr) {
-  return token.GetTokenType() == TokenType::kPunctuation
-      && static_cast<const PunctuationToken&>(token).GetAttribute() == attr;
+inline bool IsPunctuation(const TokenValue& token,
+                          const PunctuationAttribute attr) {
+  return token.type == TokenType::kPunctuation
+      && token.attribute == static_cast<int>(attr);
 }
 
 // Checks if a given token is an additive operator.
-inline bool IsAddop(const Token& token) {
-  return token.GetTokenType() == TokenType::kAddOperator;
+inline bool IsAddop(const TokenValue& token) {
+  return token.type == TokenType::kAddOperator;
 }
 
 // Checks if a given token is an addop with the specified attribute.
-inline bool IsAddop(const Token& token, const AddOperatorAttribute attr) {
-  return IsAddop(token) &&
-      static_cast<const AddOperatorToken&>(token).GetAttribute() == attr;
+inline bool IsAddop(const TokenValue& token, const AddOperatorAttribute attr) {
+  return IsAddop(token) && token.attribute == static_cast<int>(attr);
 }
 
 // Checks if a given token is a multiplicative operator.
-inline bool IsMulop(const Token& token) {
-  return token.GetTokenType() == TokenType::kMulOperator;
+inline bool IsMulop(const TokenValue& token) {
+  return token.type == TokenType::kMulOperator;
 }
 
 // Checks if a given token is a relational operator.
-inline bool IsRelop(const Token& token) {
-  return token.GetTokenType() == TokenType::kRelOperator;
+inline bool IsRelop(const TokenValue& token) {
+  return token.type == TokenType::kRelOperator;
 }
 
 // Checks if a given token is a number.
-inline bool IsNumber(const Token& token) {
-  return token.GetTokenType() == TokenType::kNumber;
+inline bool IsNumber(const TokenValue& token) {
+  return token.type == TokenType::kNumber;
+}
+
+// Returns the interned name of an identifier token.
+inline StringInterner::Id IdentifierId(const TokenValue& token) {
+  return static_cast<StringInterner::Id>(token.attribute);
 }
 
 }  // namespace
 
 bool TopdownParser::ParseProgram() {
   // PROGRAM -> program identifier ; DECL_LIST BLOCK ;
-  if (IsKeyword(*word_, KeywordAttribute::kProgram)) {
+  if (IsKeyword(word(), KeywordAttribute::kProgram)) {
     Advance();
-    if (IsIdentifier(*word_)) {
-      const std::string& id_name =
-          static_cast<const IdentifierToken&>(*word_).GetAttribute();
-      const std::string global_env_name = "_EXTERNAL";
+    if (IsIdentifier(word())) {
+      const StringInterner::Id id_name = IdentifierId(word());
+      const StringInterner::Id global_env_name =
+          interner_->Intern(std::string("_EXTERNAL"));
       symtable_.Install(id_name, global_env_name, ExpressionType::kProgram);
       current_env_ = id_name;
       main_env_ = id_name;
       Advance();
-      if (IsPunctuation(*word_, PunctuationAttribute::kSemicolon)) {
+      if (IsPunctuation(word(), PunctuationAttribute::kSemicolon)) {
         Advance();
         if (ParseDeclList()) {
           // Dump the content of symbol table.
           symtable_.Dump();
           if (ParseBlock()) {
-            if (IsPunctuation(*word_, PunctuationAttribute::kSemicolon)) {
+            if (IsPunctuation(word(), PunctuationAttribute::kSemicolon)) {
               Advance();
               return true;
             } else {
-              ReportSyntaxError("';'", *word_);
+              ReportSyntaxError("';'");
               return false;
             }
           } else {
@@ -168,15 +187,15 @@ bool TopdownParser::ParseProgram() {
           return false;
         }
       } else {
-        ReportSyntaxError("';'", *word_);
+        ReportSyntaxError("';'");
         return false;
       }
     } else {
-      ReportSyntaxError("identifier", *word_);
+      ReportSyntaxError("identifier");
       return false;
     }
   } else {
-    ReportSyntaxError("keyword 'program'", *word_);
+    ReportSyntaxError("keyword 'program'");
     return false;
   }
   return false;
@@ -189,13 +208,13 @@ bool TopdownParser::ParseDeclList() {
 
 bool TopdownParser::ParseVariableDeclList() {
   /* VARIABLE_DECL_LIST -> VARIABLE_DECL ; VARIABLE_DECL_LIST */
-  if (IsIdentifier(*word_)) {
+  if (IsIdentifier(word())) {
     if (ParseVariableDecl()) {
-      if (IsPunctuation(*word_, PunctuationAttribute::kSemicolon)) {
+      if (IsPunctuation(word(), PunctuationAttribute::kSemicolon)) {
         Advance();
         return ParseVariableDeclList();
       } else {
-        ReportSyntaxError("';'", *word_);
+        ReportSyntaxError("';'");
         return false;
       }
     } else {
@@ -210,9 +229,9 @@ bool TopdownParser::ParseVariableDeclList() {
 
 bool TopdownParser::ParseVariableDecl() {
   /* VARIABLE_DECL -> IDENTIFIER_LIST : STANDARD_TYPE */
-  if (IsIdentifier(*word_)) {
+  if (IsIdentifier(word())) {
     if (ParseIdentifierList()) {
-      if (IsPunctuation(*word_, PunctuationAttribute::kColon)) {
+      if (IsPunctuation(word(), PunctuationAttribute::kColon)) {
         ExpressionType standard_type_type = ExpressionType::kGarbage;
         Advance();
         if (ParseStandardType(&standard_type_type)) {
@@ -222,14 +241,14 @@ bool TopdownParser::ParseVariableDecl() {
           return false;
         }
       } else {
-        ReportSyntaxError("':'", *word_);
+        ReportSyntaxError("':'");
         return false;
       }
     } else {
       return false;
     }
   } else {
-    ReportSyntaxError("identifier", *word_);
+    ReportSyntaxError("identifier");
     return false;
   }
 
@@ -238,13 +257,13 @@ bool TopdownParser::ParseVariableDecl() {
 
 bool TopdownParser::ParseProcedureDeclList() {
   /* PROCEDURE_DECL_LIST -> PROCEDURE_DECL ; PROCEDURE_DECL_LIST */
-  if (IsKeyword(*word_, KeywordAttribute::kProcedure)) {
+  if (IsKeyword(word(), KeywordAttribute::kProcedure)) {
     if (ParseProcedureDecl()) {
-      if (IsPunctuation(*word_, PunctuationAttribute::kSemicolon)) {
+      if (IsPunctuation(word(), PunctuationAttribute::kSemicolon)) {
         Advance();
         return ParseProcedureDeclList();
       } else {
-        ReportSyntaxError("';'", *word_);
+        ReportSyntaxError("';'");
         return false;
       }
     } else {
@@ -260,9 +279,8 @@ bool TopdownParser::ParseProcedureDeclList() {
 
 bool TopdownParser::ParseIdentifierList() {
   /* IDENTIFIER_LIST -> identifier IDENTIFIER_LIST_PRM */
-  if (IsIdentifier(*word_)) {
-    const std::string& identifier_attr =
-        static_cast<const IdentifierToken&>(*word_).GetAttribute();
+  if (IsIdentifier(word())) {
+    const StringInterner::Id identifier_attr = IdentifierId(word());
     if (symtable_.IsDeclared(identifier_attr, current_env_)) {
       ReportMultiplyDefinedIdentifier(identifier_attr);
     } else {
@@ -272,7 +290,7 @@ bool TopdownParser::ParseIdentifierList() {
     Advance();
     return ParseIdentifierListPrm();
   } else {
-    ReportSyntaxError("identifier", *word_);
+    ReportSyntaxError("identifier");
     return false;
   }
 
@@ -281,11 +299,10 @@ bool TopdownParser::ParseIdentifierList() {
 
 bool TopdownParser::ParseIdentifierListPrm() {
   /* IDENTIFIER_LIST_PRM = , identifier IDENTIFIER_LIST_PRM */
-  if (IsPunctuation(*word_, PunctuationAttribute::kComma)) {
+  if (IsPunctuation(word(), PunctuationAttribute::kComma)) {
     Advance();
-    if (IsIdentifier(*word_)) {
-      const std::string& identifier_attr =
-          static_cast<const IdentifierToken&>(*word_).GetAttribute();
+    if (IsIdentifier(word())) {
+      const StringInterner::Id identifier_attr = IdentifierId(word());
       if (symtable_.IsDeclared(identifier_attr, current_env_)) {
         ReportMultiplyDefinedIdentifier(identifier_attr);
       } else {
@@ -301,7 +318,7 @@ bool TopdownParser::ParseIdentifierListPrm() {
       Advance();
       return ParseIdentifierListPrm();
     } else {
-      ReportSyntaxError("identifier", *word_);
+      ReportSyntaxError("identifier");
       return false;
     }
     /* IDENTIFIER_LIST_PRM = lambda */
@@ -314,12 +331,12 @@ bool TopdownParser::ParseIdentifierListPrm() {
 
 bool TopdownParser::ParseStandardType(ExpressionType* standard_type_type) {
   /* STANDARD_TYPE -> int */
-  if (IsKeyword(*word_, KeywordAttribute::kInt)) {
+  if (IsKeyword(word(), KeywordAttribute::kInt)) {
     *standard_type_type = ExpressionType::kInt;
     Advance();
     return true;
     /* STANDARD_TYPE -> bool */
-  } else if (IsKeyword(*word_, KeywordAttribute::kBool)) {
+  } else if (IsKeyword(word(), KeywordAttribute::kBool)) {
     *standard_type_type = ExpressionType::kBool;
     Advance();
     return true;
@@ -330,21 +347,21 @@ bool TopdownParser::ParseStandardType(ExpressionType* standard_type_type) {
 
 bool TopdownParser::ParseBlock() {
   /* BLOCK -> begin STMT_LIST end */
-  if (IsKeyword(*word_, KeywordAttribute::kBegin)) {
+  if (IsKeyword(word(), KeywordAttribute::kBegin)) {
     Advance();
     if (ParseStmtList()) {
-      if (IsKeyword(*word_, KeywordAttribute::kEnd)) {
+      if (IsKeyword(word(), KeywordAttribute::kEnd)) {
         Advance();
         return true;
       } else {
-        ReportSyntaxError("keyword 'end'", *word_);
+        ReportSyntaxError("keyword 'end'");
         return false;
       }
     } else {
       return false;
     }
   } else {
-    ReportSyntaxError("keyword 'begin'", *word_);
+    ReportSyntaxError("keyword 'begin'");
     return false;
   }
 
@@ -354,11 +371,10 @@ bool TopdownParser::ParseBlock() {
 bool TopdownParser::ParseProcedureDecl() {
   /* PROCEDURE_DECL ->
      procedure identifier ( PROCEDURE_ARGS ) VARIABLE_DECL_LIST BLOCK */
-  if (IsKeyword(*word_, KeywordAttribute::kProcedure)) {
+  if (IsKeyword(word(), KeywordAttribute::kProcedure)) {
     Advance();
-    if (IsIdentifier(*word_)) {
-      const std::string& identifier_attr =
-          static_cast<const IdentifierToken&>(*word_).GetAttribute();
+    if (IsIdentifier(word())) {
+      const StringInterner::Id identifier_attr = IdentifierId(word());
       if (symtable_.IsDeclared(identifier_attr, current_env_)) {
         ReportMultiplyDefinedIdentifier(identifier_attr);
       } else {
@@ -368,10 +384,10 @@ bool TopdownParser::ParseProcedureDecl() {
         formal_parm_position_ = 0;
       }
       Advance();
-      if (IsPunctuation(*word_, PunctuationAttribute::kOpenBracket)) {
+      if (IsPunctuation(word(), PunctuationAttribute::kOpenBracket)) {
         Advance();
         if (ParseProcedureArgs()) {
-          if (IsPunctuation(*word_, PunctuationAttribute::kCloseBracket)) {
+          if (IsPunctuation(word(), PunctuationAttribute::kCloseBracket)) {
             Advance();
             if (ParseVariableDeclList() && ParseBlock()) {
               current_env_ = main_env_;
@@ -380,22 +396,22 @@ bool TopdownParser::ParseProcedureDecl() {
               return false;
             }
           } else {
-            ReportSyntaxError("')'", *word_);
+            ReportSyntaxError("')'");
             return false;
           }
         } else {
           return false;
         }
       } else {
-        ReportSyntaxError("'('", *word_);
+        ReportSyntaxError("'('");
         return false;
       }
     } else {
-      ReportSyntaxError("identifier", *word_);
+      ReportSyntaxError("identifier");
       return false;
     }
   } else {
-    ReportSyntaxError("keyword 'procedure'", *word_);
+    ReportSyntaxError("keyword 'procedure'");
     return false;
   }
 
@@ -404,7 +420,7 @@ bool TopdownParser::ParseProcedureDecl() {
 
 bool TopdownParser::ParseProcedureArgs() {
   /* PROCEDURE_ARGS -> FORMAL_PARM_LIST */
-  if (IsIdentifier(*word_)) {
+  if (IsIdentifier(word())) {
     parsing_formal_parm_list_ = true;
     if (ParseFormalParmList()) {
       parsing_formal_parm_list_ = false;
@@ -423,9 +439,8 @@ bool TopdownParser::ParseProcedureArgs() {
 bool TopdownParser::ParseFormalParmList() {
   /* FORMAL_PARM_LIST ->
      identifier IDENTIFIER_LIST_PRM : STANDARD_TYPE FORMAL_PARM_LIST_HAT */
-  if (IsIdentifier(*word_)) {
-    const std::string& identifier_attr =
-        static_cast<const IdentifierToken&>(*word_).GetAttribute();
+  if (IsIdentifier(word())) {
+    const StringInterner::Id identifier_attr = IdentifierId(word());
     if (symtable_.IsDeclared(identifier_attr, current_env_)) {
       ReportMultiplyDefinedIdentifier(identifier_attr);
     } else {
@@ -435,7 +450,7 @@ bool TopdownParser::ParseFormalParmList() {
     }
     Advance();
     if (ParseIdentifierListPrm()) {
-      if (IsPunctuation(*word_, PunctuationAttribute::kColon)) {
+      if (IsPunctuation(word(), PunctuationAttribute::kColon)) {
         ExpressionType standard_type_type = ExpressionType::kGarbage;
         Advance();
         if (ParseStandardType(&standard_type_type)) {
@@ -445,14 +460,14 @@ bool TopdownParser::ParseFormalParmList() {
           return false;
         }
       } else {
-        ReportSyntaxError("':'", *word_);
+        ReportSyntaxError("':'");
         return false;
       }
     } else {
       return false;
     }
   } else {
-    ReportSyntaxError("identifier", *word_);
+    ReportSyntaxError("identifier");
     return false;
   }
 
@@ -461,7 +476,7 @@ bool TopdownParser::ParseFormalParmList() {
 
 bool TopdownParser::ParseFormalParmListHat() {
   /* FORMAL_PARM_LIST_HAT -> ; FORMAL_PARM_LIST */
-  if (IsPunctuation(*word_, PunctuationAttribute::kSemicolon)) {
+  if (IsPunctuation(word(), PunctuationAttribute::kSemicolon)) {
     Advance();
     return ParseFormalParmList();
     /* FORMAL_PARM_LIST_HAT = lambda */
@@ -474,23 +489,23 @@ bool TopdownParser::ParseFormalParmListHat() {
 
 bool TopdownParser::ParseStmtList() {
   /* STMT_LIST -> STMT ; STMT_LIST_PRM */
-  if (IsIdentifier(*word_)
-      || IsKeyword(*word_, KeywordAttribute::kIf)
-      || IsKeyword(*word_, KeywordAttribute::kWhile)
-      || IsKeyword(*word_, KeywordAttribute::kPrint)) {
+  if (IsIdentifier(word())
+      || IsKeyword(word(), KeywordAttribute::kIf)
+      || IsKeyword(word(), KeywordAttribute::kWhile)
+      || IsKeyword(word(), KeywordAttribute::kPrint)) {
     if (ParseStmt()) {
-      if (IsPunctuation(*word_, PunctuationAttribute::kSemicolon)) {
+      if (IsPunctuation(word(), PunctuationAttribute::kSemicolon)) {
         Advance();
         return ParseStmtListPrm();
       } else {
-        ReportSyntaxError("';'", *word_);
+        ReportSyntaxError("';'");
         return false;
       }
     } else {
       return false;
     }
     /* STMT_LIST -> ; STMT_LIST_PRM */
-  } else if (IsPunctuation(*word_, PunctuationAttribute::kSemicolon)) {
+  } else if (IsPunctuation(word(), PunctuationAttribute::kSemicolon)) {
     Advance();
     return ParseStmtListPrm();
   }
@@ -500,16 +515,16 @@ bool TopdownParser::ParseStmtList() {
 
 bool TopdownParser::ParseStmtListPrm() {
   /* STMT_LIST_PRM -> STMT ; STMT_LIST_PRM */
-  if (IsIdentifier(*word_)
-      || IsKeyword(*word_, KeywordAttribute::kIf)
-      || IsKeyword(*word_, KeywordAttribute::kWhile)
-      || IsKeyword(*word_, KeywordAttribute::kPrint)) {
+  if (IsIdentifier(word())
+      || IsKeyword(word(), KeywordAttribute::kIf)
+      || IsKeyword(word(), KeywordAttribute::kWhile)
+      || IsKeyword(word(), KeywordAttribute::kPrint)) {
     if (ParseStmt()) {
-      if (IsPunctuation(*word_, PunctuationAttribute::kSemicolon)) {
+      if (IsPunctuation(word(), PunctuationAttribute::kSemicolon)) {
         Advance();
         return ParseStmtListPrm();
       } else {
-        ReportSyntaxError("';'", *word_);
+        ReportSyntaxError("';'");
         return false;
       }
     } else {
@@ -525,21 +540,23 @@ bool TopdownParser::ParseStmtListPrm() {
 
 bool TopdownParser::ParseStmt() {
   /* STMT -> IF_STMT */
-  if (IsKeyword(*word_, KeywordAttribute::kIf)) {
+  if (IsKeyword(word(), KeywordAttribute::kIf)) {
     return ParseIfStmt();
     /* STMT -> WHILE_STMT */
-  } else if (IsKeyword(*word_, KeywordAttribute::kWhile)) {
+  } else if (IsKeyword(word(), KeywordAttribute::kWhile)) {
     return ParseWhileStmt();
     /* STMT -> PRINT_STMT */
-  } else if (IsKeyword(*word_, KeywordAttribute::kPrint)) {
+  } else if (IsKeyword(word(), KeywordAttribute::kPrint)) {
     return ParsePrintStmt();
     /* STMT -> identifier ADHOC_AS_PC_TAIL */
-  } else if (IsIdentifier(*word_)) {
-    const std::string& identifier_attr =
-        static_cast<const IdentifierToken&>(*word_).GetAttribute();
+  } else if (IsIdentifier(word())) {
+    const StringInterner::Id identifier_attr = IdentifierId(word());
     if (!symtable_.IsDeclared(identifier_attr, current_env_)) {
       ReportUndeclaredIdentifier(identifier_attr);
-    } else {
+    } else if (IsPunctuation(lookahead_.Peek(1),
+                             PunctuationAttribute::kOpenBracket)) {
+      // The statement is a procedure call, whose actual parameters are
+      // checked against the formal ones of that procedure.
       procedure_name_ = identifier_attr;
     }
     Advance();
@@ -561,7 +578,7 @@ bool TopdownParser::ParseStmt() {
 
 bool TopdownParser::ParseAdhocAsPcTail(ExpressionType* adhoc_as_pc_tail_type) {
   /* ADHOC_AS_PC_TAIL -> := EXPR */
-  if (IsPunctuation(*word_, PunctuationAttribute::kAssignment)) {
+  if (IsPunctuation(word(), PunctuationAttribute::kAssignment)) {
     ExpressionType expr_type_result = ExpressionType::kGarbage;
     Advance();
     if (ParseExpr(&expr_type_result)) {
@@ -571,7 +588,7 @@ bool TopdownParser::ParseAdhocAsPcTail(ExpressionType* adhoc_as_pc_tail_type) {
       return false;
     }
   /* ADHOC_AS_PC_TAIL -> ( EXPR_LIST ) */
-  } else if (IsPunctuation(*word_, PunctuationAttribute::kOpenBracket)) {
+  } else if (IsPunctuation(word(), PunctuationAttribute::kOpenBracket)) {
     ExpressionType procedure_type =
         symtable_.GetType(procedure_name_, main_env_);
     if (procedure_type != ExpressionType::kProcedure) {
@@ -580,12 +597,12 @@ bool TopdownParser::ParseAdhocAsPcTail(ExpressionType* adhoc_as_pc_tail_type) {
     actual_parm_position_ = 0;
     Advance();
     if (ParseExprList()) {
-      if (IsPunctuation(*word_, PunctuationAttribute::kCloseBracket)) {
+      if (IsPunctuation(word(), PunctuationAttribute::kCloseBracket)) {
         *adhoc_as_pc_tail_type = ExpressionType::kProcedure;
         Advance();
         return true;
       } else {
-        ReportSyntaxError("')'", *word_);
+        ReportSyntaxError("')'");
         return false;
       }
     } else {
@@ -598,25 +615,25 @@ bool TopdownParser::ParseAdhocAsPcTail(ExpressionType* adhoc_as_pc_tail_type) {
 
 bool TopdownParser::ParseIfStmt() {
   /* IF_STMT -> if EXPR then BLOCK IF_STMT_HAT */
-  if (IsKeyword(*word_, KeywordAttribute::kIf)) {
+  if (IsKeyword(word(), KeywordAttribute::kIf)) {
     Advance();
     ExpressionType expr_type_result = ExpressionType::kGarbage;
     if (ParseExpr(&expr_type_result)) {
       if (expr_type_result != ExpressionType::kBool) {
         ReportTypeError(ExpressionType::kBool, expr_type_result);
       }
-      if (IsKeyword(*word_, KeywordAttribute::kThen)) {
+      if (IsKeyword(word(), KeywordAttribute::kThen)) {
         Advance();
         return ParseBlock() && ParseIfStmtHat();
       } else {
-        ReportSyntaxError("keyword 'then'", *word_);
+        ReportSyntaxError("keyword 'then'");
         return false;
       }
     } else {
       return false;
     }
   } else {
-    ReportSyntaxError("keyword 'if'", *word_);
+    ReportSyntaxError("keyword 'if'");
     return false;
   }
 
@@ -625,7 +642,7 @@ bool TopdownParser::ParseIfStmt() {
 
 bool TopdownParser::ParseIfStmtHat() {
   /* IF_STMT_HAT -> else BLOCK */
-  if (IsKeyword(*word_, KeywordAttribute::kElse)) {
+  if (IsKeyword(word(), KeywordAttribute::kElse)) {
     Advance();
     return ParseBlock();
     /* IF_STMT_HAT -> lambda */
@@ -638,25 +655,25 @@ bool TopdownParser::ParseIfStmtHat() {
 
 bool TopdownParser::ParseWhileStmt() {
   /* WHILE_STMT -> while EXPR loop BLOCK */
-  if (IsKeyword(*word_, KeywordAttribute::kWhile)) {
+  if (IsKeyword(word(), KeywordAttribute::kWhile)) {
     Advance();
     ExpressionType expr_type_result = ExpressionType::kGarbage;
     if (ParseExpr(&expr_type_result)) {
       if (expr_type_result != ExpressionType::kBool) {
         ReportTypeError(ExpressionType::kBool, expr_type_result);
       }
-      if (IsKeyword(*word_, KeywordAttribute::kLoop)) {
+      if (IsKeyword(word(), KeywordAttribute::kLoop)) {
         Advance();
         return ParseBlock();
       } else {
-        ReportSyntaxError("keyword 'loop'", *word_);
+        ReportSyntaxError("keyword 'loop'");
         return false;
       }
     } else {
       return false;
     }
   } else {
-    ReportSyntaxError("keyword 'while'", *word_);
+    ReportSyntaxError("keyword 'while'");
     return false;
   }
 
@@ -665,7 +682,7 @@ bool TopdownParser::ParseWhileStmt() {
 
 bool TopdownParser::ParsePrintStmt() {
   /* PRINT_STMT -> print EXPR */
-  if (IsKeyword(*word_, KeywordAttribute::kPrint)) {
+  if (IsKeyword(word(), KeywordAttribute::kPrint)) {
     Advance();
     ExpressionType expr_type_result = ExpressionType::kGarbage;
     if (ParseExpr(&expr_type_result)) {
@@ -679,7 +696,7 @@ bool TopdownParser::ParsePrintStmt() {
       return false;
     }
   } else {
-    ReportSyntaxError("keyword 'print'", *word_);
+    ReportSyntaxError("keyword 'print'");
     return false;
   }
 
@@ -688,12 +705,12 @@ bool TopdownParser::ParsePrintStmt() {
 
 bool TopdownParser::ParseExprList() {
   /* EXPR_LIST -> ACTUAL_PARM_LIST */
-  if (IsIdentifier(*word_)
-      || IsNumber(*word_)
-      || IsPunctuation(*word_, PunctuationAttribute::kOpenBracket)
-      || IsAddop(*word_, AddOperatorAttribute::kAdd)
-      || IsAddop(*word_, AddOperatorAttribute::kSubtract)
-      || IsKeyword(*word_, KeywordAttribute::kNot)) {
+  if (IsIdentifier(word())
+      || IsNumber(word())
+      || IsPunctuation(word(), PunctuationAttribute::kOpenBracket)
+      || IsAddop(word(), AddOperatorAttribute::kAdd)
+      || IsAddop(word(), AddOperatorAttribute::kSubtract)
+      || IsKeyword(word(), KeywordAttribute::kNot)) {
     return ParseActualParmList();
     /* EXPR_LIST -> lambda */
   } else {
@@ -721,7 +738,7 @@ bool TopdownParser::ParseActualParmList() {
 
 bool TopdownParser::ParseActualParmListHat() {
   /* ACTUAL_PARM_LIST_HAT -> , ACTUAL_PARM_LIST */
-  if (IsPunctuation(*word_, PunctuationAttribute::kComma)) {
+  if (IsPunctuation(word(), PunctuationAttribute::kComma)) {
     Advance();
     return ParseActualParmList();
     /* ACTUAL_PARM_LIST_HAT -> lambda */
@@ -754,7 +771,7 @@ bool TopdownParser::ParseExpr(ExpressionType* expr_type_result) {
 
 bool TopdownParser::ParseExprHat(ExpressionType* expr_hat_type) {
   /* EXPR_HAT -> relop SIMPLE_EXPR */
-  if (IsRelop(*word_)) {
+  if (IsRelop(word())) {
     Advance();
     ExpressionType simple_expr_type = ExpressionType::kGarbage;
     if (ParseSimpleExpr(&simple_expr_type)) {
@@ -796,10 +813,10 @@ bool TopdownParser::ParseSimpleExpr(ExpressionType* simple_expr_type) {
 
 bool TopdownParser::ParseSimpleExprPrm(ExpressionType* simple_expr_prm0_type) {
   /* SIMPLE_EXPR_PRM -> addop TERM SIMPLE_EXPR_PRM */
-  if (IsAddop(*word_)) {
+  if (IsAddop(word())) {
     ExpressionType addop_type = ExpressionType::kGarbage;
     AddOperatorAttribute addop_attr =
-        static_cast<const AddOperatorToken&>(*word_).GetAttribute();
+        static_cast<AddOperatorAttribute>(word().attribute);
     if (addop_attr == AddOperatorAttribute::kAdd
         || addop_attr == AddOperatorAttribute::kSubtract) {
       addop_type = ExpressionType::kInt;
@@ -861,10 +878,10 @@ bool TopdownParser::ParseTerm(ExpressionType* term_type) {
 
 bool TopdownParser::ParseTermPrm(ExpressionType* term_prm0_type) {
   /* TERM_PRM -> mulop FACTOR TERM_PRM */
-  if (IsMulop(*word_)) {
+  if (IsMulop(word())) {
     ExpressionType mulop_type = ExpressionType::kGarbage;
     MulOperatorAttribute mulop_attr = MulOperatorAttribute::kUnspecified;
-    mulop_attr = static_cast<const MulOperatorToken&>(*word_).GetAttribute();
+    mulop_attr = static_cast<MulOperatorAttribute>(word().attribute);
     if (mulop_attr == MulOperatorAttribute::kMultiply
         || mulop_attr == MulOperatorAttribute::kDivide) {
       mulop_type = ExpressionType::kInt;
@@ -899,9 +916,8 @@ bool TopdownParser::ParseTermPrm(ExpressionType* term_prm0_type) {
 
 bool TopdownParser::ParseFactor(ExpressionType* factor0_type) {
   /* FACTOR -> identifier */
-  if (IsIdentifier(*word_)) {
-    const std::string& identifier_attr =
-        static_cast<const IdentifierToken&>(*word_).GetAttribute();
+  if (IsIdentifier(word())) {
+    const StringInterner::Id identifier_attr = IdentifierId(word());
     if (!symtable_.IsDeclared(identifier_attr, current_env_)) {
       ReportUndeclaredIdentifier(identifier_attr);
     } else {
@@ -910,30 +926,30 @@ bool TopdownParser::ParseFactor(ExpressionType* factor0_type) {
     Advance();
     return true;
     /* FACTOR -> num */
-  } else if (IsNumber(*word_)) {
+  } else if (IsNumber(word())) {
     *factor0_type = ExpressionType::kInt;
     Advance();
     return true;
     /* FACTOR -> ( EXPR ) */
-  } else if (IsPunctuation(*word_, PunctuationAttribute::kOpenBracket)) {
+  } else if (IsPunctuation(word(), PunctuationAttribute::kOpenBracket)) {
     Advance();
     ExpressionType expr_type_result = ExpressionType::kGarbage;
     if (ParseExpr(&expr_type_result)) {
-      if (IsPunctuation(*word_, PunctuationAttribute::kCloseBracket)) {
+      if (IsPunctuation(word(), PunctuationAttribute::kCloseBracket)) {
         *factor0_type = expr_type_result;
         Advance();
         return true;
       } else {
-        ReportSyntaxError("')'", *word_);
+        ReportSyntaxError("')'");
         return false;
       }
     } else {
       return false;
     }
     /* FACTOR -> SIGN FACTOR */
-  } else if (IsAddop(*word_, AddOperatorAttribute::kAdd)
-             || IsAddop(*word_, AddOperatorAttribute::kSubtract)
-             || IsKeyword(*word_, KeywordAttribute::kNot)) {
+  } else if (IsAddop(word(), AddOperatorAttribute::kAdd)
+             || IsAddop(word(), AddOperatorAttribute::kSubtract)
+             || IsKeyword(word(), KeywordAttribute::kNot)) {
     ExpressionType sign_type = ExpressionType::kGarbage;
     ExpressionType factor1_type = ExpressionType::kGarbage;
     if (ParseSign(&sign_type) && ParseFactor(&factor1_type)) {
@@ -953,17 +969,17 @@ bool TopdownParser::ParseFactor(ExpressionType* factor0_type) {
 
 bool TopdownParser::ParseSign(ExpressionType* sign_type) {
   /* SIGN -> + */
-  if (IsAddop(*word_, AddOperatorAttribute::kAdd)) {
+  if (IsAddop(word(), AddOperatorAttribute::kAdd)) {
     *sign_type = ExpressionType::kInt;
     Advance();
     return true;
     /* SIGN -> - */
-  } else if (IsAddop(*word_, AddOperatorAttribute::kSubtract)) {
+  } else if (IsAddop(word(), AddOperatorAttribute::kSubtract)) {
     *sign_type = ExpressionType::kInt;
     Advance();
     return true;
     /* SIGN -> not */
-  } else if (IsKeyword(*word_, KeywordAttribute::kNot)) {
+  } else if (IsKeyword(word(), KeywordAttribute::kNot)) {
     *sign_type = ExpressionType::kBool;
     Advance();
     return true;
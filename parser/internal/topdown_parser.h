@@ -7,9 +7,12 @@
 #include <memory>
 #include <string>
 
+#include "parser/internal/lookahead_ring.h"
 #include "parser/symbol_table.h"
 #include "scanner/scanner.h"
 #include "tokens/token.h"
+#include "tokens/token_value.h"
+#include "util/string_interner.h"
 
 namespace truplc {
 namespace internal {
@@ -30,10 +33,16 @@ class TopdownParser {
   // The Scanner associated with this TopdownParser.
   std::unique_ptr<Scanner> scanner_;
 
+  // Pool of identifier names shared by the scanner and the symbol table.
+  StringInterner* const interner_;
+
   /*********** Syntax Analysis **********/
   // Advance to the next token.
   void Advance();
 
+  // Returns the token that is being examined.
+  TokenValue word() const { return lookahead_.Current(); }
+
   // Parser functions for each non-terminal in TruPL.
   bool ParseDeclList();
   bool ParseVariableDeclList();
@@ -67,30 +76,33 @@ class TopdownParser {
   bool ParseFactor(ExpressionType* factor_type);
   bool ParseSign(ExpressionType* sign_type);
 
-  // Reports syntax errors to console.
+  // Returns " at line L, column C" for the token being examined, or an empty
+  // string if the source text is not kept in memory.
+  std::string DescribeLocation() const;
+
+  // Reports syntax errors about the token being examined to console.
   // Message format: "Parse error! Expected: *expected" Actual: *actual*.
-  void ReportSyntaxError(const std::string& expected,
-                         const Token& actual) const;
+  void ReportSyntaxError(const std::string& expected);
 
-  // The token that is being examined.
-  std::unique_ptr<Token> word_;
+  // Upcoming tokens, starting with the one that is being examined.
+  LookaheadRing lookahead_;
 
   /*********** Semantial Analysis **********/
   // Reports semantic errors to console. These include declaring a previously
   // defined identifier, manipulating an undeclared identifier and type mismatch
-  // errors.
-  void ReportMultiplyDefinedIdentifier(const std::string& identifier) const;
-  void ReportUndeclaredIdentifier(const std::string& identifier) const;
+  // errors. Identifier errors are reported at the token being examined.
+  void ReportMultiplyDefinedIdentifier(StringInterner::Id identifier) const;
+  void ReportUndeclaredIdentifier(StringInterner::Id identifier) const;
   void ReportTypeError(ExpressionType expected, ExpressionType actual) const;
   void ReportTypeError(ExpressionType expected0, ExpressionType expected1,
                        ExpressionType actual) const;
 
-  // Name of current environment that is being parsed.
-  std::string current_env_;
-  // Name of environment of main program.
-  std::string main_env_;
-  // Name of potential procedure when examining a procedure call.
-  std::string procedure_name_;
+  // Interned name of current environment that is being parsed.
+  StringInterner::Id current_env_;
+  // Interned name of environment of main program.
+  StringInterner::Id main_env_;
+  // Interned name of potential procedure when examining a procedure call.
+  StringInterner::Id procedure_name_;
   // Position of an actual parameter in a procedure call.
   int actual_parm_position_;
   // Position of a formal parameter in a procedure call.
@@ -6,6 +6,30 @@
 #include "util/string_util.h"
 
 namespace truplc {
+namespace {
+
+// Initial number of slots of an index.
+const size_t kInitialSlots = 64;
+
+// Returns the key of an identifier in an environment.
+uint64_t NameKey(const StringInterner::Id identifier,
+                 const StringInterner::Id environment) {
+  return static_cast<uint64_t>(environment) << 32 | identifier;
+}
+
+// Returns the key of the formal parameter in a position of a procedure.
+uint64_t PositionKey(const StringInterner::Id procedure, const int position) {
+  return static_cast<uint64_t>(procedure) << 32 |
+         static_cast<uint32_t>(position);
+}
+
+// Returns a hash of a key whose low bits depend on all of its bits.
+uint64_t HashKey(const uint64_t key) {
+  const uint64_t hash = key * 0x9E3779B97F4A7C15u;
+  return hash ^ hash >> 32;
+}
+
+}  // namespace
 
 std::string DebugString(const ExpressionType type) {
   std::string debug_str;
@@ -43,6 +67,51 @@ std::string DebugString(const ExpressionType type) {
   return debug_str;;
 }
 
+SymbolTable::SymbolTable()
+    : own_interner_(new StringInterner()), interner_(own_interner_.get()) {}
+
+SymbolTable::SymbolTable(StringInterner* const interner)
+    : interner_(interner) {}
+
+void SymbolTable::Install(const StringInterner::Id identifier,
+                          const StringInterner::Id environment,
+                          const ExpressionType type) {
+  Install(identifier, environment, type, -1);
+}
+
+void SymbolTable::Install(const StringInterner::Id identifier,
+                          const StringInterner::Id environment,
+                          const ExpressionType type,
+                          const int position) {
+  const uint32_t index = static_cast<uint32_t>(table_.size());
+  table_.push_back(Entry(identifier, environment, type, position));
+  by_name_.Insert(NameKey(identifier, environment), index);
+  by_position_.Insert(PositionKey(environment, position), index);
+  if (type == ExpressionType::kUnknown) {
+    unknown_.push_back(index);
+  }
+}
+
+bool SymbolTable::IsDeclared(const StringInterner::Id identifier,
+                             const StringInterner::Id environment) const {
+  return by_name_.Find(NameKey(identifier, environment)) != Index::kNoEntry;
+}
+
+ExpressionType SymbolTable::GetType(const StringInterner::Id identifier,
+                                    const StringInterner::Id environment)
+    const {
+  const uint32_t index = by_name_.Find(NameKey(identifier, environment));
+  return index == Index::kNoEntry ? ExpressionType::kGarbage
+                                  : table_[index].type;
+}
+
+ExpressionType SymbolTable::GetType(const StringInterner::Id procedure,
+                                    const int position) const {
+  const uint32_t index = by_position_.Find(PositionKey(procedure, position));
+  return index == Index::kNoEntry ? ExpressionType::kGarbage
+                                  : table_[index].type;
+}
+
 void SymbolTable::Install(const std::string& identifier,
                           const std::string& environment,
                           const ExpressionType type) {
@@ -53,45 +122,34 @@ void SymbolTable::Install(const std::string& identifier,
                           const std::string& environment,
                           const ExpressionType type,
                           const int position) {
-  table_.push_back(Entry(identifier, environment, type, position));
+  Install(interner_->Intern(identifier), interner_->Intern(environment), type,
+          position);
 }
 
 void SymbolTable::UpdateType(const ExpressionType type) {
-  for (Entry& entry : table_) {
-    if (entry.type == ExpressionType::kUnknown) {
-      entry.type = type;
-    }
+  if (type == ExpressionType::kUnknown) {
+    return;
+  }
+  for (const uint32_t index : unknown_) {
+    table_[index].type = type;
   }
+  unknown_.clear();
 }
 
 bool SymbolTable::IsDeclared(const std::string& identifier,
                              const std::string& environment) const {
-  for (const Entry& entry : table_) {
-    if (entry.identifier == identifier && entry.environment == environment) {
-      return true;
-    }
-  }
-  return false;
+  // Names that were never interned cannot have been installed.
+  return IsDeclared(interner_->Find(identifier), interner_->Find(environment));
 }
 
 ExpressionType SymbolTable::GetType(const std::string& identifier,
                                     const std::string& environment) const {
-  for (const Entry& entry : table_) {
-    if (entry.identifier == identifier && entry.environment == environment) {
-      return entry.type;
-    }
-  }
-  return ExpressionType::kGarbage;
+  return GetType(interner_->Find(identifier), interner_->Find(environment));
 }
 
 ExpressionType SymbolTable::GetType(const std::string& procedure,
                                     const int position) const {
-  for (const Entry& entry : table_) {
-    if (entry.environment == procedure && entry.position == position) {
-      return entry.type;
-    }
-  }
-  return ExpressionType::kGarbage;
+  return GetType(interner_->Find(procedure), position);
 }
 
 std::string SymbolTable::Dump() const {
@@ -105,8 +163,55 @@ std::string SymbolTable::Dump() const {
 
 std::string SymbolTable::DumpEntry(const Entry& entry) const {
   return Format("ID: %s ENV: %s TYPE: %s POS: %d",
-                entry.identifier.c_str(), entry.environment.c_str(),
+                interner_->Lookup(entry.identifier).ToString().c_str(),
+                interner_->Lookup(entry.environment).ToString().c_str(),
                 DebugString(entry.type).c_str(), entry.position);
 }
 
+const uint32_t SymbolTable::Index::kNoEntry;
+
+SymbolTable::Index::Index() : slots_(kInitialSlots, {0, kNoEntry}), size_(0) {}
+
+uint32_t SymbolTable::Index::Find(const uint64_t key) const {
+  return slots_[FindSlot(key)].entry;
+}
+
+void SymbolTable::Index::Insert(const uint64_t key, const uint32_t entry) {
+  size_t slot = FindSlot(key);
+  if (slots_[slot].entry != kNoEntry) {
+    return;
+  }
+  if (2 * (size_ + 1) > slots_.size()) {
+    Grow();
+    slot = FindSlot(key);
+  }
+  slots_[slot] = {key, entry};
+  ++size_;
+}
+
+size_t SymbolTable::Index::FindSlot(const uint64_t key) const {
+  const size_t mask = slots_.size() - 1;
+  for (size_t slot = HashKey(key) & mask;; slot = (slot + 1) & mask) {
+    if (slots_[slot].entry == kNoEntry || slots_[slot].key == key) {
+      return slot;
+    }
+  }
+}
+
+void SymbolTable::Index::Grow() {
+  std::vector<Slot> slots(2 * slots_.size(), {0, kNoEntry});
+  const size_t mask = slots.size() - 1;
+  for (const Slot& old_slot : slots_) {
+    if (old_slot.entry == kNoEntry) {
+      continue;
+    }
+    size_t slot = HashKey(old_slot.key) & mask;
+    while (slots[slot].entry != kNoEntry) {
+      slot = (slot + 1) & mask;
+    }
+    slots[slot] = old_slot;
+  }
+  slots_.swap(slots);
+}
+
 }  // namespace truplc
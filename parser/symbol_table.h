@@ -1,12 +1,19 @@
 // Symbol table to register and store attributes associated with TruPL tokens.
+// Entries are kept in installation order and found through hash indexes, so
+// that lookups take constant time however many identifiers are declared.
 // Copyright 2016 Hieu Le.
 
 #ifndef TRUPLC_PARSER_SYMBOL_TABLE_H__
 #define TRUPLC_PARSER_SYMBOL_TABLE_H__
 
+#include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <string>
 #include <vector>
 
+#include "util/string_interner.h"
+
 namespace truplc {
 
 // Types of expressions that the semantic analyzer must manipulate.
@@ -27,6 +34,39 @@ std::string DebugString(ExpressionType type);
 
 class SymbolTable {
  public:
+  // Constructs a symbol table that interns names into a pool of its own.
+  SymbolTable();
+
+  // Constructs a symbol table keyed by names interned into a given pool, such
+  // as the one of the scanner. The pool must outlive the table.
+  explicit SymbolTable(StringInterner* interner);
+
+  // Installs an identifier with specified environment and type. Names are
+  // given by their ids in the pool of this table.
+  void Install(StringInterner::Id identifier, StringInterner::Id environment,
+               ExpressionType type);
+
+  // Installs a formal paramater of a procedure with specified environment, type
+  // and position in the associated procedure parameter list.
+  void Install(StringInterner::Id identifier, StringInterner::Id environment,
+               ExpressionType type, int position);
+
+  // Checks if an identifier belonging to a specified environment has been
+  // declared.
+  bool IsDeclared(StringInterner::Id identifier,
+                  StringInterner::Id environment) const;
+
+  // Returns the type of an identifier from a specified environment. Returns
+  // garbage type if identifier has not been declared.
+  ExpressionType GetType(StringInterner::Id identifier,
+                         StringInterner::Id environment) const;
+
+  // Returns the type of the formal parameter in the indicated position of a
+  // procedure. Returns garbage type if formal parameter has not been defined.
+  ExpressionType GetType(StringInterner::Id procedure, int position) const;
+
+  // Overloads of the above taking names as strings.
+
   // Installs an identifier with specified environment and type.
   void Install(const std::string& identifier, const std::string& environment,
                ExpressionType type);
@@ -63,14 +103,14 @@ class SymbolTable {
   struct Entry {
     // Constructs a symbol table entry from specified identifier, environment,
     // position (if any) and datatype.
-    Entry(const std::string& id, const std::string& env,
+    Entry(const StringInterner::Id id, const StringInterner::Id env,
           const ExpressionType t, const int pos)
         : identifier(id), environment(env), type(t), position(pos) {}
 
-    // Identifier's name.
-    const std::string identifier;
-    // Environment this identifier is declared in.
-    const std::string environment;
+    // Interned id of the identifier's name.
+    StringInterner::Id identifier;
+    // Interned id of the environment this identifier is declared in.
+    StringInterner::Id environment;
     // Data type of this identifier.
     ExpressionType type;
     // Position in formal parameter list if this identifier is a formal
@@ -78,11 +118,64 @@ class SymbolTable {
     const int position;
   };
 
+  // Open-addressed hash table mapping 64-bit keys to the first entry
+  // installed under each key, probed linearly.
+  class Index {
+   public:
+    // Value returned for keys that map to no entry.
+    static const uint32_t kNoEntry = 0xFFFFFFFF;
+
+    // Constructs an empty index.
+    Index();
+
+    // Returns the entry a key maps to, or kNoEntry.
+    uint32_t Find(uint64_t key) const;
+
+    // Maps a key to an entry, unless the key already maps to one.
+    void Insert(uint64_t key, uint32_t entry);
+
+   private:
+    // A key and its entry. Empty slots hold kNoEntry.
+    struct Slot {
+      uint64_t key;
+      uint32_t entry;
+    };
+
+    // Returns the index of the slot holding a key, or of the empty slot where
+    // the key belongs.
+    size_t FindSlot(uint64_t key) const;
+
+    // Doubles the number of slots and reinserts every key.
+    void Grow();
+
+    // The number of slots is a power of two and at least twice size_.
+    std::vector<Slot> slots_;
+
+    // Number of keys in the index.
+    size_t size_;
+  };
+
   // Returns the content of a single entry in debug-friendly format.
   std::string DumpEntry(const Entry& entry) const;
 
-  // Container of entries from the symbol table.
+  // Pool owned by this table when it is not given one.
+  std::unique_ptr<StringInterner> own_interner_;
+
+  // Pool of the names of identifiers and environments.
+  StringInterner* interner_;
+
+  // Container of entries from the symbol table, in installation order.
   std::vector<Entry> table_;
+
+  // Entries keyed by identifier and environment.
+  Index by_name_;
+
+  // Entries keyed by environment and position, which finds the formal
+  // parameters of procedures.
+  Index by_position_;
+
+  // Entries whose type is unknown until the next call to UpdateType().
+  std::vector<uint32_t> unknown_;
 };
 
 }  // namespace truplc
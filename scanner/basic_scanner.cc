@@ -0,0 +1,250 @@
+// Implementation for BasicScanner class template.
+// Copyright 2016 Hieu Le.
+
+#include "scanner/basic_scanner.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <utility>
+
+#include "scanner/char_class.h"
+#include "scanner/keyword_table.h"
+#include "scanner/lexer_table.h"
+#include "scanner/source_manager.h"
+#include "tokens/error_token.h"
+#include "tokens/identifier_token.h"
+#include "tokens/number_token.h"
+#include "tokens/token_registry.h"
+#include "util/decimal.h"
+#include "util/string_util.h"
+#include "util/text_colorizer.h"
+
+namespace truplc {
+namespace {
+
+// Checks if a given character represents a space.
+bool IsSpace(const char c) {
+  return c == kSpace;
+}
+
+// Checks if a given character ends the malformed input skipped on a lexical
+// error. Letters, digits and invalid characters are skipped.
+bool IsDelimiter(const char c) {
+  return c == kSpace || c == kEOFMarker || (GetCharClass(c) & kSymbolClass);
+}
+
+// Creates a token of type T for a lexeme and any further constructor
+// arguments, in an arena if there is one. The token refers to the lexeme in
+// place when it stays valid for the lifetime of the buffer; otherwise the
+// lexeme is copied.
+template <typename T, typename... Args>
+TokenHandle NewLexemeToken(const StringPiece lexeme, const bool stable,
+                           Arena* const arena, const Args&... args) {
+  if (arena != nullptr) {
+    return TokenHandle::Shared(arena->New<T>(
+        stable ? lexeme : arena->CopyString(lexeme), args...));
+  }
+  return TokenHandle(stable
+                         ? std::make_unique<T>(lexeme, args...)
+                         : std::make_unique<T>(lexeme.ToString(), args...));
+}
+
+}  // namespace
+
+namespace internal {
+
+TokenHandle NewToken(const TokenValue& value, const StringPiece lexeme,
+                     const int64_t number, const bool stable,
+                     const StringInterner* interner, Arena* const arena) {
+  switch (value.type) {
+    case TokenType::kIdentifier:
+      if (interner != nullptr) {
+        const StringInterner::Id id =
+            static_cast<StringInterner::Id>(value.attribute);
+        if (arena != nullptr) {
+          return TokenHandle::Shared(
+              arena->New<IdentifierToken>(interner->Lookup(id), id));
+        }
+        return TokenHandle(
+            std::make_unique<IdentifierToken>(interner->Lookup(id), id));
+      }
+      return NewLexemeToken<IdentifierToken>(lexeme, stable, arena);
+    case TokenType::kNumber:
+      return NewLexemeToken<NumberToken>(lexeme, stable, arena, number);
+    case TokenType::kError:
+      if (arena != nullptr) {
+        return TokenHandle::Shared(arena->New<ErrorToken>(lexeme.ToString()));
+      }
+      return TokenHandle(std::make_unique<ErrorToken>(lexeme.ToString()));
+    default:
+      // Any other token is fully described by its type and attribute.
+      return TokenHandle::Shared(
+          FindSharedToken(value.type, value.attribute));
+  }
+}
+
+}  // namespace internal
+
+template <typename BufferT, bool kCountStats>
+BasicScanner<BufferT, kCountStats>::BasicScanner(std::unique_ptr<BufferT> buffer,
+                                    StringInterner* const interner)
+    : buffer_(std::move(buffer)),
+      interner_(interner),
+      number_(0),
+      error_log_(nullptr),
+      arena_(nullptr),
+      stats_(nullptr) {}
+
+template <typename BufferT, bool kCountStats>
+void BasicScanner<BufferT, kCountStats>::EnableErrorRecovery(
+    LexicalErrorLog* const error_log) {
+  error_log_ = error_log;
+  buffer_->set_recover_invalid_chars(true);
+}
+
+template <typename BufferT, bool kCountStats>
+void BasicScanner<BufferT, kCountStats>::ScannerFatalError(const std::string& message,
+                                              const size_t offset) const {
+  const StringPiece text = buffer_->Text();
+  const std::string location = text.data() == nullptr
+      ? std::string() : SourceManager(text).Describe(offset);
+  TextColorizer::Print(std::cerr, TextColorizer::kFGRedColorizer,
+                       StrCat("Exiting on Scanner Fatal Error: ",
+                              message + location, "\n"));
+  exit(EXIT_FAILURE);
+}
+
+template <typename BufferT, bool kCountStats>
+TokenValue BasicScanner<BufferT, kCountStats>::RecoverFromError(size_t length, char c) {
+  const size_t offset = buffer_->MarkOffset() + length;
+  // The buffer returns a marker in place of a character outside the alphabet,
+  // but the original character is still sliced.
+  ++length;
+  const char original = buffer_->Slice(length)[length - 1];
+  const int index = static_cast<int>(error_log_->size());
+  error_log_->Record(offset, StrCat(c == kInvalidMarker
+                                        ? "Invalid character: "
+                                        : "Illegal character: ",
+                                    std::string(1, original)));
+
+  // Resynchronize at the next delimiter, which starts the next token unless it
+  // is a space.
+  for (c = buffer_->NextChar(); !IsDelimiter(c); c = buffer_->NextChar()) {
+    ++length;
+  }
+  if (!IsSpace(c)) {
+    PutBack(c);
+  }
+  lexeme_ = buffer_->Slice(length);
+  return {TokenType::kError, index,
+          static_cast<uint32_t>(buffer_->MarkOffset()),
+          static_cast<uint32_t>(length)};
+}
+
+template <typename BufferT, bool kCountStats>
+TokenValue BasicScanner<BufferT, kCountStats>::NextTokenValue() {
+  const internal::LexerTable& table = internal::kLexerTable;
+  uint8_t state = internal::kStartState;
+  size_t length = 0;
+
+  // Lexemes are sliced out of the buffer once complete.
+  buffer_->Mark();
+
+  // Scanning stops once the error limit is reached.
+  if (error_log_ != nullptr && error_log_->full()) {
+    if (kCountStats) {
+      stats_->CountErrorLimit();
+    }
+    lexeme_ = StringPiece();
+    return {TokenType::kEOF, 0,
+            static_cast<uint32_t>(buffer_->MarkOffset()), 0};
+  }
+
+  // Follow the transition table until the character read does not extend the
+  // lexeme any further.
+  char c;
+  for (;;) {
+    c = buffer_->NextChar();
+    const uint8_t next =
+        table.next[state][table.byte_class[static_cast<unsigned char>(c)]];
+    if (next == internal::kNoState) {
+      break;
+    }
+    state = next;
+    ++length;
+  }
+
+  lexeme_ = buffer_->Slice(length);
+  internal::LexemeAction action = table.action[state];
+  if (action.type == TokenType::kIdentifier) {
+    // Keywords and word operators are scanned as identifiers first.
+    action = internal::FindWord(lexeme_);
+    if (action.type == TokenType::kIdentifier && interner_ != nullptr) {
+      action.attribute = static_cast<int>(interner_->Intern(lexeme_));
+    }
+  } else if (action.type == TokenType::kNumber) {
+    // The literal is converted once, here, and its value travels with the
+    // token from then on.
+    if (!ParseDecimal(lexeme_, &number_)) {
+      const std::string message =
+          StrCat("Integer literal out of range: ", lexeme_.ToString());
+      if (error_log_ == nullptr) {
+        ScannerFatalError(message, buffer_->MarkOffset());
+      }
+      action = {TokenType::kError, static_cast<int>(error_log_->size())};
+      error_log_->Record(buffer_->MarkOffset(), message);
+    }
+  } else if (action.type == TokenType::kUnspecified) {
+    if (c != kEOFMarker) {
+      if (error_log_ != nullptr) {
+        return RecoverFromError(length, c);
+      }
+      ScannerFatalError(StrCat("Illegal character: ", std::string(1, c)),
+                        buffer_->MarkOffset() + length);
+    }
+    action.type = TokenType::kEOF;
+  }
+
+  // A space only delimits the lexeme; any other character starts the next one.
+  if (!IsSpace(c)) {
+    PutBack(c);
+  }
+  return {action.type, action.attribute,
+          static_cast<uint32_t>(buffer_->MarkOffset()),
+          static_cast<uint32_t>(length)};
+}
+
+template <typename BufferT, bool kCountStats>
+size_t BasicScanner<BufferT, kCountStats>::TokenizeInto(TokenStream* const stream,
+                                           const size_t max_tokens) {
+  for (size_t count = 0; count < max_tokens;) {
+    const TokenValue value = NextTokenValue();
+    stream->push_back(value, number_);
+    ++count;
+    if (value.type == TokenType::kEOF) {
+      return count;
+    }
+  }
+  return max_tokens;
+}
+
+template <typename BufferT, bool kCountStats>
+TokenHandle BasicScanner<BufferT, kCountStats>::NextToken() {
+  return MakeToken(NextTokenValue());
+}
+
+template <typename BufferT, bool kCountStats>
+TokenHandle BasicScanner<BufferT, kCountStats>::MakeToken(const TokenValue& value) const {
+  return internal::NewToken(value, lexeme_, number_,
+                            buffer_->HasStableSlices(), interner_, arena_);
+}
+
+template class BasicScanner<Buffer>;
+template class BasicScanner<MemoryBuffer>;
+template class BasicScanner<StreamBuffer>;
+template class BasicScanner<Buffer, true>;
+template class BasicScanner<MemoryBuffer, true>;
+template class BasicScanner<StreamBuffer, true>;
+
+}  // namespace truplc
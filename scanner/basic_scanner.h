@@ -0,0 +1,173 @@
+// The table-driven lexical analyzer for the TruPL compiler, parameterized on
+// the type of its character buffer. Buffers whose character access is final,
+// such as MemoryBuffer and StreamBuffer, have NextChar() bound statically and
+// inlined into the scanning loop. If kCountStats is true, the characters put
+// back into the buffer are counted into statistics; otherwise counting is
+// compiled out.
+// Copyright 2016 Hieu Le.
+
+#ifndef TRUPLC_SCANNER_BASIC_SCANNER_H__
+#define TRUPLC_SCANNER_BASIC_SCANNER_H__
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "scanner/buffer.h"
+#include "scanner/lexical_error_log.h"
+#include "scanner/memory_buffer.h"
+#include "scanner/scan_stats.h"
+#include "scanner/stream_buffer.h"
+#include "tokens/token.h"
+#include "tokens/token_handle.h"
+#include "tokens/token_stream.h"
+#include "tokens/token_value.h"
+#include "util/arena.h"
+#include "util/string_interner.h"
+#include "util/string_piece.h"
+
+namespace truplc {
+namespace internal {
+
+// Returns the token object for a token value scanned from a given lexeme.
+// number is the value of a number token, as converted by the scanner, and is
+// ignored for other tokens. Identifier, number and error tokens are allocated:
+// they refer to the lexeme in place if stable is true, and copy it otherwise.
+// Identifier names are taken from an interner if there is one. If an arena is
+// given, the tokens and the copied lexemes are allocated in it and the handle
+// does not own them. Other tokens are shared instances. The handle is empty if
+// the type or attribute is unknown.
+TokenHandle NewToken(const TokenValue& value, StringPiece lexeme,
+                     int64_t number, bool stable,
+                     const StringInterner* interner, Arena* arena = nullptr);
+
+}  // namespace internal
+
+template <typename BufferT, bool kCountStats = false>
+class BasicScanner {
+ public:
+  // Constructs a scanner as wrapper on a given buffer. BufferT must be Buffer
+  // or one of its subclasses. If an interner is given, identifier names are
+  // interned into it: token values carry the id of the name as attribute and
+  // identifier tokens refer to the interned characters. The interner must
+  // outlive the scanner.
+  explicit BasicScanner(std::unique_ptr<BufferT> buffer,
+                        StringInterner* interner = nullptr);
+
+  // Takes over a scanner which may already be partway through its input, and
+  // counts the characters it puts back from then on into given statistics,
+  // which must outlive the scanner.
+  template <bool kOtherCountStats>
+  BasicScanner(BasicScanner<BufferT, kOtherCountStats>&& scanner,
+               ScanStats* const stats)
+      : buffer_(std::move(scanner.buffer_)),
+        interner_(scanner.interner_),
+        lexeme_(scanner.lexeme_),
+        number_(scanner.number_),
+        error_log_(scanner.error_log_),
+        arena_(scanner.arena_),
+        stats_(stats) {}
+
+  // Returns the next token in the buffer as a value, without allocating.
+  TokenValue NextTokenValue();
+
+  // Appends the next tokens in the buffer to a stream, along with the values
+  // of number tokens, up to max_tokens of them or up to and including the EOF
+  // token, whichever comes first. Returns the number of tokens appended.
+  size_t TokenizeInto(TokenStream* stream, size_t max_tokens);
+
+  // Returns the lexeme of the token last returned by NextTokenValue(). The
+  // piece remains valid until the next call to NextTokenValue(), or for the
+  // lifetime of the buffer if the buffer has stable slices.
+  StringPiece Lexeme() const { return lexeme_; }
+
+  // Returns the value of the number token last returned by NextTokenValue().
+  // Each literal is converted once, while it is scanned.
+  int64_t NumberValue() const { return number_; }
+
+  // Returns the whole input if the buffer holds it in memory, or a piece with
+  // null data otherwise.
+  StringPiece Text() const { return buffer_->Text(); }
+
+  // Returns the number of blocks the buffer has read from its source.
+  size_t RefillCount() const { return buffer_->RefillCount(); }
+
+  // Returns the next token in the buffer as a token object. Only identifier,
+  // number and error tokens are allocated; they may refer to source text
+  // owned by the buffer and must not outlive it.
+  TokenHandle NextToken();
+
+  // Returns the token object for the token value last returned by
+  // NextTokenValue().
+  TokenHandle MakeToken(const TokenValue& value) const;
+
+  // Makes the scanner recover from lexical errors instead of exiting. Each
+  // error is recorded into a given log, which must outlive the scanner, and
+  // scanned as an error token whose attribute is the index of the error in
+  // the log. Once the log is full, only the EOF token is returned.
+  void EnableErrorRecovery(LexicalErrorLog* error_log);
+
+  // Makes the scanner allocate identifier, number and error tokens, and the
+  // lexemes they copy, in a given arena instead of the heap. The tokens are
+  // then owned by the arena, which must outlive the handles to them.
+  void UseArena(Arena* arena) { arena_ = arena; }
+
+ private:
+  template <typename, bool>
+  friend class BasicScanner;
+
+  // Places a delimiting character back into the buffer, counting it if
+  // kCountStats is true.
+  void PutBack(const char c) {
+    if (kCountStats) {
+      stats_->CountPushback();
+    }
+    buffer_->UnreadChar(c);
+  }
+
+  // If a lexical error OR an internal scanner error occurs, call this method.
+  // It will print the message and exit. The location of the character at a
+  // given offset is appended to the message when the input is in memory.
+  void ScannerFatalError(const std::string& message, size_t offset) const;
+
+  // Records the lexical error on character c, read after the first length
+  // characters of the lexeme, and skips the malformed input up to the next
+  // delimiter. Returns the error token spanning the skipped input.
+  TokenValue RecoverFromError(size_t length, char c);
+
+  // The character buffer.
+  std::unique_ptr<BufferT> buffer_;
+
+  // Pool of identifier names, or null if names are not interned.
+  StringInterner* const interner_;
+
+  // Lexeme of the last scanned token.
+  StringPiece lexeme_;
+
+  // Value of the last scanned number token.
+  int64_t number_;
+
+  // Log of lexical errors, or null if the scanner exits on the first one.
+  LexicalErrorLog* error_log_;
+
+  // Arena in which tokens are allocated, or null to allocate them on the heap.
+  Arena* arena_;
+
+  // Statistics to count into, if kCountStats is true.
+  ScanStats* stats_;
+};
+
+// Instantiated once in basic_scanner.cc. BasicScanner<Buffer> serves any
+// buffer through virtual calls. File buffers are scanned through their
+// MemoryBuffer or StreamBuffer base.
+extern template class BasicScanner<Buffer>;
+extern template class BasicScanner<MemoryBuffer>;
+extern template class BasicScanner<StreamBuffer>;
+extern template class BasicScanner<Buffer, true>;
+extern template class BasicScanner<MemoryBuffer, true>;
+extern template class BasicScanner<StreamBuffer, true>;
+
+}  // namespace truplc
+
+#endif  // TRUPLC_SCANNER_BASIC_SCANNER_H__
@@ -3,12 +3,9 @@
 
 #include "scanner/buffer.h"
 
-#include <cctype>
-
-#include <algorithm>
 #include <iostream>
 
-#include "util/container_util.h"
+#include "scanner/char_class.h"
 #include "util/string_util.h"
 #include "util/text_colorizer.h"
 
@@ -21,7 +18,7 @@ void Buffer::BufferFatalError(const std::string& message) const {
 }
 
 bool Buffer::Validate(const char c) {
-  return std::islower(c) || std::isdigit(c) || Contain(kNonAlphanum, c);
+  return IsAlphabetChar(c);
 }
 
 }  // namespace truplc
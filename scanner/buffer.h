@@ -4,13 +4,20 @@
 #ifndef TRUPLC_SCANNER_BUFFER_H__
 #define TRUPLC_SCANNER_BUFFER_H__
 
+#include <cstddef>
 #include <string>
 
+#include "util/string_piece.h"
+
 namespace truplc {
 
 // Not part of TruPL alphabet. Used only by the lexical analyzer to denote EOF.
 const char kEOFMarker     = '$';
 
+// Not part of TruPL alphabet. Returned in place of a character outside the
+// alphabet when the buffer recovers from invalid characters.
+const char kInvalidMarker = '\0';
+
 /* -------------------------------------------------------------------------- */
 // The TruPL input alphabet consists of all alphabetic ASCII characters, the
 // digits [0..9], and the following non-alphanumeric characters.
@@ -23,7 +30,7 @@ const char kSpace         = ' ';
 const char kTab           = '\t';
 const char kNewLine       = '\n';
 
-const char kNonAlphanum[] =
+constexpr char kNonAlphanum[] =
 {';', ':', '(', ')', ',', '=', '>', '<', '+', '-', '*', '/',
  kCommentMarker, kSpace, kTab, kNewLine};
 
@@ -45,6 +52,40 @@ class Buffer {
   // intervening call to NextChar().
   virtual void UnreadChar(char c) = 0;
 
+  // Marks the character returned by the next call to NextChar() as the start
+  // of a lexeme. That character must not be a delimiting space.
+  virtual void Mark() = 0;
+
+  // Returns the lexeme made of the first length characters returned by
+  // NextChar() since the last call to Mark(), without copying them. The lexeme
+  // must not span a delimiting space. The returned piece points into the
+  // buffer window and remains valid until the next call to Mark(), or for the
+  // lifetime of the buffer if HasStableSlices() returns true.
+  virtual StringPiece Slice(size_t length) const = 0;
+
+  // Returns the offset of the character marked by the last call to Mark()
+  // from the start of the input.
+  virtual size_t MarkOffset() const = 0;
+
+  // Checks if the pieces returned by Slice() remain valid for the lifetime of
+  // the buffer.
+  virtual bool HasStableSlices() const { return false; }
+
+  // Returns the whole input if the buffer holds it in memory, or a piece
+  // with null data otherwise. Used to locate diagnostics.
+  virtual StringPiece Text() const { return StringPiece(); }
+
+  // Returns the number of blocks of characters read from the source so far.
+  // Buffers holding the whole input in memory never refill.
+  virtual size_t RefillCount() const { return 0; }
+
+  // Sets whether a character outside the TruPL alphabet is returned as
+  // kInvalidMarker by NextChar() instead of terminating the program. The
+  // original character can still be sliced. Off by default.
+  void set_recover_invalid_chars(const bool recover) {
+    recover_invalid_chars_ = recover;
+  }
+
  protected:
   // Prints an error message and then exits. Intended when something
   // catastrophic happens in the buffer.
@@ -53,6 +94,9 @@ class Buffer {
   // Checks if a specified character c belongs to the TruPL alphabet.
   // Returns true if it does; false otherwise.
   bool Validate(char c);
+
+  // Whether invalid characters are returned as kInvalidMarker.
+  bool recover_invalid_chars_ = false;
 };
 
 }  // namespace truplc
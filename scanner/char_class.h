@@ -0,0 +1,84 @@
+// Character classification for the TruPL input alphabet. Every byte is mapped
+// to a set of class flags through a 256-entry table computed at compile time,
+// so each query is a single load instead of a chain of comparisons.
+// Copyright 2016 Hieu Le.
+
+#ifndef TRUPLC_SCANNER_CHAR_CLASS_H__
+#define TRUPLC_SCANNER_CHAR_CLASS_H__
+
+#include <cstdint>
+
+#include "scanner/buffer.h"
+
+namespace truplc {
+
+// Flags describing the classes a character belongs to.
+enum CharClass : uint8_t {
+  kLowerClass      = 1 << 0,  // a-z
+  kDigitClass      = 1 << 1,  // 0-9
+  kWhitespaceClass = 1 << 2,  // space, tab and new line
+  kSymbolClass     = 1 << 3,  // Any other member of kNonAlphanum.
+};
+
+// Union of the classes making up the TruPL alphabet.
+const uint8_t kAlphabetClass =
+    kLowerClass | kDigitClass | kWhitespaceClass | kSymbolClass;
+
+// Table of class flags indexed by unsigned character value.
+struct CharClassTable {
+  uint8_t flags[256];
+};
+
+// Builds the character class table from the alphabet defined in buffer.h.
+constexpr CharClassTable MakeCharClassTable() {
+  CharClassTable table = {};
+  for (int c = 'a'; c <= 'z'; ++c) {
+    table.flags[c] |= kLowerClass;
+  }
+  for (int c = '0'; c <= '9'; ++c) {
+    table.flags[c] |= kDigitClass;
+  }
+  for (const char c : kNonAlphanum) {
+    table.flags[static_cast<unsigned char>(c)] |=
+        c == kSpace || c == kTab || c == kNewLine
+        ? kWhitespaceClass : kSymbolClass;
+  }
+  return table;
+}
+
+constexpr CharClassTable kCharClassTable = MakeCharClassTable();
+
+// Returns the class flags of a given character.
+inline uint8_t GetCharClass(const char c) {
+  return kCharClassTable.flags[static_cast<unsigned char>(c)];
+}
+
+// Checks if a given character represents a lowercase letter.
+inline bool IsAlpha(const char c) {
+  return GetCharClass(c) & kLowerClass;
+}
+
+// Checks if a given character represents a digit.
+inline bool IsDigit(const char c) {
+  return GetCharClass(c) & kDigitClass;
+}
+
+// Checks if a given character represents a lowercase letter or a digit.
+inline bool IsAlphanumeric(const char c) {
+  return GetCharClass(c) & (kLowerClass | kDigitClass);
+}
+
+// Checks if given character represents a whitespace symbol. Whitespaces consist
+// of space (' '), tab ('\t') and new line ('\n') characters.
+inline bool IsWhitespace(const char c) {
+  return GetCharClass(c) & kWhitespaceClass;
+}
+
+// Checks if a given character belongs to the TruPL alphabet.
+inline bool IsAlphabetChar(const char c) {
+  return GetCharClass(c) & kAlphabetClass;
+}
+
+}  // namespace truplc
+
+#endif  // TRUPLC_SCANNER_CHAR_CLASS_H__
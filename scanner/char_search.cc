@@ -0,0 +1,317 @@
+// Implementation for block-oriented character searches.
+// Copyright 2016 Hieu Le.
+
+#include "scanner/char_search.h"
+
+#include "scanner/buffer.h"
+#include "scanner/char_class.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define TRUPLC_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
+namespace truplc {
+namespace {
+
+// Signature shared by every search implementation.
+using SearchFunction = const char* (*)(const char* begin, const char* end);
+
+// Signature shared by every counting implementation.
+using CountFunction = size_t (*)(const char* begin, const char* end);
+
+// Set of search implementations bound to one instruction set.
+struct SearchFunctions {
+  SearchFunction find_non_whitespace;
+  SearchFunction find_new_line;
+  SearchFunction find_invalid_char;
+  CountFunction count_new_lines;
+};
+
+const char* ScalarFindNonWhitespace(const char* begin, const char* end) {
+  while (begin != end && IsWhitespace(*begin)) {
+    ++begin;
+  }
+  return begin;
+}
+
+const char* ScalarFindNewLine(const char* begin, const char* end) {
+  while (begin != end && *begin != kNewLine) {
+    ++begin;
+  }
+  return begin;
+}
+
+const char* ScalarFindInvalidChar(const char* begin, const char* end) {
+  while (begin != end && IsAlphabetChar(*begin)) {
+    ++begin;
+  }
+  return begin;
+}
+
+size_t ScalarCountNewLines(const char* begin, const char* end) {
+  size_t count = 0;
+  for (; begin != end; ++begin) {
+    count += *begin == kNewLine;
+  }
+  return count;
+}
+
+#ifdef TRUPLC_X86_SIMD
+
+// The vector loops below only load whole blocks that lie inside [begin, end)
+// and hand the remaining tail over to the scalar loops.
+//
+// Alphabet membership is tested with range checks: a byte x lies in [lo, hi]
+// iff min(x - lo, hi - lo) == x - lo in unsigned arithmetic. The alphabet is
+// a-z, the range '(' to '>' except '.', plus '#', space, tab and new line.
+
+__attribute__((target("sse2")))
+const char* SSE2FindNonWhitespace(const char* begin, const char* end) {
+  const __m128i space = _mm_set1_epi8(kSpace);
+  const __m128i tab = _mm_set1_epi8(kTab);
+  const __m128i new_line = _mm_set1_epi8(kNewLine);
+  for (; end - begin >= 16; begin += 16) {
+    const __m128i block =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+    const __m128i whitespace = _mm_or_si128(
+        _mm_or_si128(_mm_cmpeq_epi8(block, space), _mm_cmpeq_epi8(block, tab)),
+        _mm_cmpeq_epi8(block, new_line));
+    const unsigned mask = ~_mm_movemask_epi8(whitespace) & 0xFFFFu;
+    if (mask != 0) {
+      return begin + __builtin_ctz(mask);
+    }
+  }
+  return ScalarFindNonWhitespace(begin, end);
+}
+
+__attribute__((target("sse2")))
+const char* SSE2FindNewLine(const char* begin, const char* end) {
+  const __m128i new_line = _mm_set1_epi8(kNewLine);
+  for (; end - begin >= 16; begin += 16) {
+    const __m128i block =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+    const unsigned mask =
+        _mm_movemask_epi8(_mm_cmpeq_epi8(block, new_line));
+    if (mask != 0) {
+      return begin + __builtin_ctz(mask);
+    }
+  }
+  return ScalarFindNewLine(begin, end);
+}
+
+// Returns a mask with all bits set in every byte of x that lies in [lo, hi].
+__attribute__((target("sse2")))
+inline __m128i SSE2InRange(const __m128i x, const char lo, const char hi) {
+  const __m128i offset = _mm_sub_epi8(x, _mm_set1_epi8(lo));
+  return _mm_cmpeq_epi8(_mm_min_epu8(offset, _mm_set1_epi8(hi - lo)), offset);
+}
+
+__attribute__((target("sse2")))
+const char* SSE2FindInvalidChar(const char* begin, const char* end) {
+  const __m128i dot = _mm_set1_epi8('.');
+  const __m128i comment = _mm_set1_epi8(kCommentMarker);
+  const __m128i space = _mm_set1_epi8(kSpace);
+  for (; end - begin >= 16; begin += 16) {
+    const __m128i block =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+    const __m128i symbol = _mm_andnot_si128(_mm_cmpeq_epi8(block, dot),
+                                            SSE2InRange(block, '(', '>'));
+    const __m128i valid = _mm_or_si128(
+        _mm_or_si128(SSE2InRange(block, 'a', 'z'), symbol),
+        _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(block, comment),
+                         _mm_cmpeq_epi8(block, space)),
+            SSE2InRange(block, kTab, kNewLine)));
+    const unsigned mask = ~_mm_movemask_epi8(valid) & 0xFFFFu;
+    if (mask != 0) {
+      return begin + __builtin_ctz(mask);
+    }
+  }
+  return ScalarFindInvalidChar(begin, end);
+}
+
+__attribute__((target("sse2")))
+size_t SSE2CountNewLines(const char* begin, const char* end) {
+  const __m128i new_line = _mm_set1_epi8(kNewLine);
+  size_t count = 0;
+  for (; end - begin >= 16; begin += 16) {
+    const __m128i block =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+    count += __builtin_popcount(
+        _mm_movemask_epi8(_mm_cmpeq_epi8(block, new_line)));
+  }
+  return count + ScalarCountNewLines(begin, end);
+}
+
+__attribute__((target("avx2")))
+const char* AVX2FindNonWhitespace(const char* begin, const char* end) {
+  const __m256i space = _mm256_set1_epi8(kSpace);
+  const __m256i tab = _mm256_set1_epi8(kTab);
+  const __m256i new_line = _mm256_set1_epi8(kNewLine);
+  for (; end - begin >= 32; begin += 32) {
+    const __m256i block =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin));
+    const __m256i whitespace = _mm256_or_si256(
+        _mm256_or_si256(_mm256_cmpeq_epi8(block, space),
+                        _mm256_cmpeq_epi8(block, tab)),
+        _mm256_cmpeq_epi8(block, new_line));
+    const unsigned mask =
+        ~static_cast<unsigned>(_mm256_movemask_epi8(whitespace));
+    if (mask != 0) {
+      return begin + __builtin_ctz(mask);
+    }
+  }
+  return SSE2FindNonWhitespace(begin, end);
+}
+
+__attribute__((target("avx2")))
+const char* AVX2FindNewLine(const char* begin, const char* end) {
+  const __m256i new_line = _mm256_set1_epi8(kNewLine);
+  for (; end - begin >= 32; begin += 32) {
+    const __m256i block =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin));
+    const unsigned mask = static_cast<unsigned>(
+        _mm256_movemask_epi8(_mm256_cmpeq_epi8(block, new_line)));
+    if (mask != 0) {
+      return begin + __builtin_ctz(mask);
+    }
+  }
+  return SSE2FindNewLine(begin, end);
+}
+
+// Returns a mask with all bits set in every byte of x that lies in [lo, hi].
+__attribute__((target("avx2")))
+inline __m256i AVX2InRange(const __m256i x, const char lo, const char hi) {
+  const __m256i offset = _mm256_sub_epi8(x, _mm256_set1_epi8(lo));
+  return _mm256_cmpeq_epi8(_mm256_min_epu8(offset, _mm256_set1_epi8(hi - lo)),
+                           offset);
+}
+
+__attribute__((target("avx2")))
+const char* AVX2FindInvalidChar(const char* begin, const char* end) {
+  const __m256i dot = _mm256_set1_epi8('.');
+  const __m256i comment = _mm256_set1_epi8(kCommentMarker);
+  const __m256i space = _mm256_set1_epi8(kSpace);
+  for (; end - begin >= 32; begin += 32) {
+    const __m256i block =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin));
+    const __m256i symbol = _mm256_andnot_si256(
+        _mm256_cmpeq_epi8(block, dot), AVX2InRange(block, '(', '>'));
+    const __m256i valid = _mm256_or_si256(
+        _mm256_or_si256(AVX2InRange(block, 'a', 'z'), symbol),
+        _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(block, comment),
+                            _mm256_cmpeq_epi8(block, space)),
+            AVX2InRange(block, kTab, kNewLine)));
+    const unsigned mask =
+        ~static_cast<unsigned>(_mm256_movemask_epi8(valid));
+    if (mask != 0) {
+      return begin + __builtin_ctz(mask);
+    }
+  }
+  return SSE2FindInvalidChar(begin, end);
+}
+
+__attribute__((target("avx2")))
+size_t AVX2CountNewLines(const char* begin, const char* end) {
+  const __m256i new_line = _mm256_set1_epi8(kNewLine);
+  size_t count = 0;
+  for (; end - begin >= 32; begin += 32) {
+    const __m256i block =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin));
+    count += __builtin_popcount(static_cast<unsigned>(
+        _mm256_movemask_epi8(_mm256_cmpeq_epi8(block, new_line))));
+  }
+  return count + SSE2CountNewLines(begin, end);
+}
+
+#else  // TRUPLC_X86_SIMD
+
+// Without x86 vector extensions every level maps to the scalar loops.
+const SearchFunction SSE2FindNonWhitespace = ScalarFindNonWhitespace;
+const SearchFunction SSE2FindNewLine = ScalarFindNewLine;
+const SearchFunction SSE2FindInvalidChar = ScalarFindInvalidChar;
+const SearchFunction AVX2FindNonWhitespace = ScalarFindNonWhitespace;
+const SearchFunction AVX2FindNewLine = ScalarFindNewLine;
+const SearchFunction AVX2FindInvalidChar = ScalarFindInvalidChar;
+const CountFunction SSE2CountNewLines = ScalarCountNewLines;
+const CountFunction AVX2CountNewLines = ScalarCountNewLines;
+
+#endif  // TRUPLC_X86_SIMD
+
+// Returns the search implementations for a given instruction set.
+const SearchFunctions& GetSearchFunctions(const internal::SimdLevel level) {
+  static const SearchFunctions kFunctions[] = {
+    {ScalarFindNonWhitespace, ScalarFindNewLine, ScalarFindInvalidChar,
+     ScalarCountNewLines},
+    {SSE2FindNonWhitespace, SSE2FindNewLine, SSE2FindInvalidChar,
+     SSE2CountNewLines},
+    {AVX2FindNonWhitespace, AVX2FindNewLine, AVX2FindInvalidChar,
+     AVX2CountNewLines},
+  };
+  return kFunctions[static_cast<int>(level)];
+}
+
+// Returns the search implementations for the host CPU.
+const SearchFunctions& GetHostSearchFunctions() {
+  static const SearchFunctions& functions =
+      GetSearchFunctions(internal::DetectSimdLevel());
+  return functions;
+}
+
+}  // namespace
+
+const char* FindNonWhitespace(const char* begin, const char* end) {
+  return GetHostSearchFunctions().find_non_whitespace(begin, end);
+}
+
+const char* FindNewLine(const char* begin, const char* end) {
+  return GetHostSearchFunctions().find_new_line(begin, end);
+}
+
+const char* FindInvalidChar(const char* begin, const char* end) {
+  return GetHostSearchFunctions().find_invalid_char(begin, end);
+}
+
+size_t CountNewLines(const char* begin, const char* end) {
+  return GetHostSearchFunctions().count_new_lines(begin, end);
+}
+
+namespace internal {
+
+SimdLevel DetectSimdLevel() {
+#ifdef TRUPLC_X86_SIMD
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) {
+    return SimdLevel::kAVX2;
+  }
+  if (__builtin_cpu_supports("sse2")) {
+    return SimdLevel::kSSE2;
+  }
+#endif  // TRUPLC_X86_SIMD
+  return SimdLevel::kScalar;
+}
+
+const char* FindNonWhitespace(const char* begin, const char* end,
+                              const SimdLevel level) {
+  return GetSearchFunctions(level).find_non_whitespace(begin, end);
+}
+
+const char* FindNewLine(const char* begin, const char* end,
+                        const SimdLevel level) {
+  return GetSearchFunctions(level).find_new_line(begin, end);
+}
+
+const char* FindInvalidChar(const char* begin, const char* end,
+                            const SimdLevel level) {
+  return GetSearchFunctions(level).find_invalid_char(begin, end);
+}
+
+size_t CountNewLines(const char* begin, const char* end,
+                     const SimdLevel level) {
+  return GetSearchFunctions(level).count_new_lines(begin, end);
+}
+
+}  // namespace internal
+}  // namespace truplc
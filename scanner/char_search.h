@@ -0,0 +1,55 @@
+// Block-oriented searches over raw source characters. Each search examines 16
+// or 32 characters at a time with SSE2 or AVX2 instructions when the host CPU
+// supports them, and falls back to a scalar loop otherwise. The best
+// implementation is chosen once at runtime via CPUID.
+// Copyright 2016 Hieu Le.
+
+#ifndef TRUPLC_SCANNER_CHAR_SEARCH_H__
+#define TRUPLC_SCANNER_CHAR_SEARCH_H__
+
+#include <cstddef>
+
+namespace truplc {
+
+// Returns a pointer to the first character in [begin, end) that is not a
+// whitespace symbol, i.e. not a space, tab or new line. Returns end if there
+// is no such character.
+const char* FindNonWhitespace(const char* begin, const char* end);
+
+// Returns a pointer to the first new line character in [begin, end). Returns
+// end if there is no such character.
+const char* FindNewLine(const char* begin, const char* end);
+
+// Returns a pointer to the first character in [begin, end) that does not
+// belong to the TruPL alphabet. Returns end if the whole range is valid.
+const char* FindInvalidChar(const char* begin, const char* end);
+
+// Returns the number of new line characters in [begin, end).
+size_t CountNewLines(const char* begin, const char* end);
+
+namespace internal {
+
+// Instruction sets a search can be carried out with, from least to most
+// capable.
+enum class SimdLevel : int {
+  kScalar = 0,
+  kSSE2   = 1,
+  kAVX2   = 2,
+};
+
+// Returns the most capable instruction set supported by the host CPU.
+SimdLevel DetectSimdLevel();
+
+// Variants of the searches above bound to a specific instruction set. The
+// level must not exceed DetectSimdLevel(). Exposed for testing.
+const char* FindNonWhitespace(const char* begin, const char* end,
+                              SimdLevel level);
+const char* FindNewLine(const char* begin, const char* end, SimdLevel level);
+const char* FindInvalidChar(const char* begin, const char* end,
+                            SimdLevel level);
+size_t CountNewLines(const char* begin, const char* end, SimdLevel level);
+
+}  // namespace internal
+}  // namespace truplc
+
+#endif  // TRUPLC_SCANNER_CHAR_SEARCH_H__
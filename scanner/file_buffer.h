@@ -6,32 +6,31 @@
 
 #include <fstream>
 #include <string>
-#include <memory>
 
-#include "scanner/buffer.h"
+#include "scanner/stream_buffer.h"
 
 namespace truplc {
+namespace internal {
 
-class FileBuffer : public Buffer {
- public:
-  // Opens input program file and initializes the buffer.
-  explicit FileBuffer(const std::string& filename);
-
-  // Closes the file and performs any needed clean-up.
-  ~FileBuffer();
-
-  // Removes and returns the next character from the buffer.n
-  char NextChar() override;
-
-  // Places a character back into the buffer.
-  void UnreadChar(char c) override;
+// Owns the stream of a FileBuffer. Kept as a base class so that the file is
+// opened before the StreamBuffer base starts reading it.
+class SourceFileStream {
+ protected:
+  // Opens a given file for reading.
+  explicit SourceFileStream(const std::string& filename)
+      : source_file_(filename) {}
 
- private:
   // The stream object for the source file.
   std::ifstream source_file_;
+};
+
+}  // namespace internal
 
-  // The composed stream buffer.
-  std::unique_ptr<Buffer> buffer_;
+class FileBuffer : private internal::SourceFileStream, public StreamBuffer {
+ public:
+  // Opens input program file and initializes the buffer. Characters are read
+  // directly by the StreamBuffer base, without any forwarding.
+  explicit FileBuffer(const std::string& filename);
 };
 
 }  // namespace truplc
@@ -0,0 +1,282 @@
+// Implementation for IncrementalLexer class.
+// Copyright 2016 Hieu Le.
+
+#include "scanner/incremental_lexer.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <utility>
+
+#include "scanner/basic_scanner.h"
+#include "scanner/buffer.h"
+#include "scanner/char_search.h"
+#include "scanner/lexical_error_log.h"
+#include "scanner/memory_buffer.h"
+
+namespace truplc {
+namespace {
+
+// Checks if two tokens have the same type, attribute and length.
+bool SameToken(const TokenValue& a, const TokenValue& b) {
+  return a.type == b.type && a.attribute == b.attribute &&
+         a.length == b.length;
+}
+
+// Returns the index of the first token starting at or after a given offset.
+size_t FirstTokenFrom(const std::vector<TokenValue>& tokens,
+                      const size_t offset) {
+  return std::lower_bound(tokens.begin(), tokens.end(), offset,
+                          [](const TokenValue& value, const size_t offset) {
+                            return value.offset < offset;
+                          }) - tokens.begin();
+}
+
+// Returns the end of a chunk of about chunk_size characters starting at
+// begin in text: right after the first new line that completes chunk_size
+// characters, or the end of text if there is none.
+size_t ChunkEnd(const StringPiece text, const size_t begin,
+                const size_t chunk_size) {
+  if (text.size() - begin <= chunk_size) {
+    return text.size();
+  }
+  const char* const end = text.data() + text.size();
+  const char* const new_line =
+      FindNewLine(text.data() + begin + chunk_size - 1, end);
+  return new_line == end ? text.size() : new_line + 1 - text.data();
+}
+
+}  // namespace
+
+const size_t IncrementalLexer::kDefaultChunkSize;
+
+IncrementalLexer::IncrementalLexer(const StringPiece text,
+                                   const size_t chunk_size)
+    : chunk_size_(std::max<size_t>(1, chunk_size)),
+      size_(0),
+      token_count_(0) {
+  size_t begin = 0;
+  do {
+    const size_t end = ChunkEnd(text, begin, chunk_size_);
+    chunks_.emplace_back();
+    Chunk& chunk = chunks_.back();
+    chunk.text.assign(text.data() + begin, end - begin);
+    Scan(chunk.text, 0, chunk.text.size(), &chunk.tokens);
+    begin = end;
+  } while (begin < text.size());
+  Reindex(0);
+}
+
+bool IncrementalLexer::Edit(const size_t offset, const size_t removed,
+                            const StringPiece inserted,
+                            TokenChange* const change) {
+  if (offset > size_ || removed > size_ - offset) {
+    return false;
+  }
+
+  // Chunks start on line boundaries, so the lines touched by the edit lie in
+  // the chunks holding its first and last characters, merged into one.
+  const size_t c = ChunkAt(offset);
+  Merge(c, ChunkAt(offset + removed));
+  Chunk& chunk = chunks_[c];
+  std::string& text = chunk.text;
+  std::vector<TokenValue>& tokens = chunk.tokens;
+  const size_t at_offset = offset - chunk.start;
+
+  // The edit touches the lines from the one holding offset to the one holding
+  // the last removed character, without the new line ending them.
+  const size_t new_line = at_offset == 0
+      ? std::string::npos : text.rfind(kNewLine, at_offset - 1);
+  const size_t begin = new_line == std::string::npos ? 0 : new_line + 1;
+  const size_t old_end =
+      std::min(text.find(kNewLine, at_offset + removed), text.size());
+  const size_t first = FirstTokenFrom(tokens, begin);
+  const size_t last = FirstTokenFrom(tokens, old_end);
+
+  text.replace(at_offset, removed, inserted.data(), inserted.size());
+  const size_t new_end = old_end - removed + inserted.size();
+  std::vector<TokenValue> scanned;
+  Scan(text, begin, new_end, &scanned);
+
+  // Tokens of the touched lines outside the edited characters are usually
+  // scanned again as they were; they are not reported as changed. Offsets
+  // following the edit move by delta, modulo 2^32.
+  const uint32_t delta = static_cast<uint32_t>(inserted.size() - removed);
+  size_t prefix = 0;
+  while (prefix < scanned.size() && first + prefix < last &&
+         tokens[first + prefix].offset + tokens[first + prefix].length <=
+             at_offset &&
+         scanned[prefix].offset == tokens[first + prefix].offset &&
+         SameToken(scanned[prefix], tokens[first + prefix])) {
+    ++prefix;
+  }
+  size_t suffix = 0;
+  while (suffix < scanned.size() - prefix &&
+         suffix < last - first - prefix &&
+         tokens[last - suffix - 1].offset >= at_offset + removed &&
+         scanned[scanned.size() - suffix - 1].offset ==
+             tokens[last - suffix - 1].offset + delta &&
+         SameToken(scanned[scanned.size() - suffix - 1],
+                   tokens[last - suffix - 1])) {
+    ++suffix;
+  }
+
+  // Overwrite the changed tokens in place, so that the following ones move
+  // at most once. Only the tokens of this chunk move: those of later chunks
+  // are relative to their own chunk.
+  const size_t at = first + prefix;
+  const size_t removed_tokens = last - first - prefix - suffix;
+  const size_t inserted_tokens = scanned.size() - prefix - suffix;
+  const size_t common = std::min(removed_tokens, inserted_tokens);
+  const auto new_tokens = scanned.begin() + prefix;
+  std::copy(new_tokens, new_tokens + common, tokens.begin() + at);
+  if (removed_tokens > inserted_tokens) {
+    tokens.erase(tokens.begin() + at + common,
+                 tokens.begin() + at + removed_tokens);
+  } else {
+    tokens.insert(tokens.begin() + at + common, new_tokens + common,
+                  new_tokens + inserted_tokens);
+  }
+  if (delta != 0) {
+    for (size_t i = at + inserted_tokens; i < tokens.size(); ++i) {
+      tokens[i].offset += delta;
+    }
+  }
+
+  if (change != nullptr) {
+    *change = {chunk.first_token + at, removed_tokens, inserted_tokens};
+  }
+  Reindex(Rebalance(c));
+  return true;
+}
+
+std::string IncrementalLexer::text() const {
+  std::string text;
+  text.reserve(size_);
+  for (const Chunk& chunk : chunks_) {
+    text += chunk.text;
+  }
+  return text;
+}
+
+TokenValue IncrementalLexer::token(const size_t i) const {
+  const Chunk& chunk = chunks_[ChunkOfToken(i)];
+  TokenValue value = chunk.tokens[i - chunk.first_token];
+  value.offset += static_cast<uint32_t>(chunk.start);
+  return value;
+}
+
+StringPiece IncrementalLexer::Lexeme(const size_t i) const {
+  const Chunk& chunk = chunks_[ChunkOfToken(i)];
+  const TokenValue& value = chunk.tokens[i - chunk.first_token];
+  return StringPiece(chunk.text.data() + value.offset, value.length);
+}
+
+size_t IncrementalLexer::ChunkAt(const size_t offset) const {
+  return std::upper_bound(chunks_.begin() + 1, chunks_.end(), offset,
+                          [](const size_t offset, const Chunk& chunk) {
+                            return offset < chunk.start;
+                          }) - chunks_.begin() - 1;
+}
+
+size_t IncrementalLexer::ChunkOfToken(const size_t i) const {
+  // Chunks without tokens share their first token with the next chunk; the
+  // last chunk starting at or before i is the one holding it.
+  return std::upper_bound(chunks_.begin() + 1, chunks_.end(), i,
+                          [](const size_t i, const Chunk& chunk) {
+                            return i < chunk.first_token;
+                          }) - chunks_.begin() - 1;
+}
+
+void IncrementalLexer::Merge(const size_t c, const size_t last) {
+  if (last == c) {
+    return;
+  }
+  Chunk& chunk = chunks_[c];
+  for (size_t i = c + 1; i <= last; ++i) {
+    const uint32_t shift = static_cast<uint32_t>(chunk.text.size());
+    chunk.text += chunks_[i].text;
+    for (TokenValue value : chunks_[i].tokens) {
+      value.offset += shift;
+      chunk.tokens.push_back(value);
+    }
+  }
+  chunks_.erase(chunks_.begin() + c + 1, chunks_.begin() + last + 1);
+}
+
+void IncrementalLexer::Split(const size_t c) {
+  Chunk whole = std::move(chunks_[c]);
+  std::vector<Chunk> pieces;
+  size_t begin = 0;
+  size_t token = 0;
+  do {
+    const size_t end = ChunkEnd(whole.text, begin, chunk_size_);
+    pieces.emplace_back();
+    Chunk& piece = pieces.back();
+    piece.text.assign(whole.text, begin, end - begin);
+    for (; token < whole.tokens.size() && whole.tokens[token].offset < end;
+         ++token) {
+      TokenValue value = whole.tokens[token];
+      value.offset -= static_cast<uint32_t>(begin);
+      piece.tokens.push_back(value);
+    }
+    begin = end;
+  } while (begin < whole.text.size());
+  chunks_[c] = std::move(pieces.front());
+  chunks_.insert(chunks_.begin() + c + 1,
+                 std::make_move_iterator(pieces.begin() + 1),
+                 std::make_move_iterator(pieces.end()));
+}
+
+size_t IncrementalLexer::Rebalance(size_t c) {
+  if (chunks_.size() > 1 && chunks_[c].text.size() <= chunk_size_ / 4) {
+    if (c + 1 == chunks_.size()) {
+      --c;
+    }
+    Merge(c, c + 1);
+  }
+  if (chunks_[c].text.size() > 2 * chunk_size_) {
+    Split(c);
+  }
+  return c;
+}
+
+void IncrementalLexer::Reindex(const size_t c) {
+  size_t start = 0;
+  size_t first_token = 0;
+  if (c > 0) {
+    const Chunk& previous = chunks_[c - 1];
+    start = previous.start + previous.text.size();
+    first_token = previous.first_token + previous.tokens.size();
+  }
+  for (size_t i = c; i < chunks_.size(); ++i) {
+    chunks_[i].start = start;
+    chunks_[i].first_token = first_token;
+    start += chunks_[i].text.size();
+    first_token += chunks_[i].tokens.size();
+  }
+  size_ = start;
+  token_count_ = first_token;
+}
+
+void IncrementalLexer::Scan(const std::string& text, const size_t begin,
+                            const size_t end,
+                            std::vector<TokenValue>* const tokens) {
+  BasicScanner<MemoryBuffer> scanner(
+      std::make_unique<MemoryBuffer>(text, begin, end), &interner_);
+  // Documents being edited are often malformed. Errors are only kept as
+  // tokens, so the log has no limit and is dropped once the lines are
+  // scanned.
+  LexicalErrorLog errors(0);
+  scanner.EnableErrorRecovery(&errors);
+  for (TokenValue value = scanner.NextTokenValue();
+       value.type != TokenType::kEOF; value = scanner.NextTokenValue()) {
+    if (value.type == TokenType::kError) {
+      value.attribute = 0;
+    }
+    tokens->push_back(value);
+  }
+}
+
+}  // namespace truplc
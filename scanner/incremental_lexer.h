@@ -0,0 +1,140 @@
+// Keeps the tokens of a document up to date as it is edited, for editor
+// integrations. TruPL tokens and comments never span a new line, so every
+// line starts in the same scanner state: an edit only re-scans the lines it
+// touches, and the new tokens are spliced in place of the old ones. The
+// document is held in chunks of whole lines, each with its own tokens at
+// offsets relative to the chunk, so that an edit rewrites the chunks it
+// touches rather than the whole document and every token following it.
+// Copyright 2016 Hieu Le.
+
+#ifndef TRUPLC_SCANNER_INCREMENTAL_LEXER_H__
+#define TRUPLC_SCANNER_INCREMENTAL_LEXER_H__
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "tokens/token_value.h"
+#include "util/string_interner.h"
+#include "util/string_piece.h"
+
+namespace truplc {
+
+// Range of tokens replaced by an edit. Tokens before first are unchanged,
+// and so are the tokens after it, apart from their offsets.
+struct TokenChange {
+  // Index of the first replaced token.
+  size_t first;
+
+  // Number of tokens removed from first on.
+  size_t removed;
+
+  // Number of tokens inserted at first.
+  size_t inserted;
+};
+
+class IncrementalLexer {
+ public:
+  // Default number of characters per chunk. A chunk is split once it grows
+  // past twice this size, and merged into a neighbor once it shrinks to a
+  // quarter of it.
+  static const size_t kDefaultChunkSize = 4096;
+
+  // Constructs a lexer over a copy of a given document, held in chunks of
+  // about chunk_size characters, and scans it whole.
+  explicit IncrementalLexer(StringPiece text,
+                            size_t chunk_size = kDefaultChunkSize);
+
+  // Replaces removed characters from offset on by inserted text and re-scans
+  // the lines touched by the edit. Stores the range of tokens that changed
+  // into change unless it is null. Returns false, leaving the document
+  // unchanged, if the removed characters run past the end of the document.
+  // Takes time proportional to the size of the chunks holding the edit, plus
+  // a small constant per chunk of the document to move the later chunks.
+  bool Edit(size_t offset, size_t removed, StringPiece inserted,
+            TokenChange* change);
+
+  // Returns the number of characters in the current document.
+  size_t size() const { return size_; }
+
+  // Returns a copy of the current document. Takes time proportional to its
+  // size.
+  std::string text() const;
+
+  // Returns the number of tokens of the current document, without the EOF
+  // token.
+  size_t token_count() const { return token_count_; }
+
+  // Returns the i-th token of the current document, with its offset from the
+  // start of the document. Lexical errors are scanned as kError tokens with
+  // attribute 0.
+  TokenValue token(size_t i) const;
+
+  // Returns the lexeme of the i-th token.
+  StringPiece Lexeme(size_t i) const;
+
+  // Returns the pool of identifier names. Identifier attributes are ids of
+  // names in this pool; names are never removed from it.
+  const StringInterner& interner() const { return interner_; }
+
+ private:
+  // Run of whole lines of the document, and their tokens.
+  struct Chunk {
+    // Characters of the lines. Every chunk but the last ends with a new line.
+    std::string text;
+
+    // Tokens of the lines, at offsets from the start of the chunk.
+    std::vector<TokenValue> tokens;
+
+    // Offset of the chunk in the document, and index in the document of its
+    // first token.
+    size_t start;
+    size_t first_token;
+  };
+
+  // Returns the index of the chunk holding the character at a given offset,
+  // or of the last chunk if offset is the size of the document.
+  size_t ChunkAt(size_t offset) const;
+
+  // Returns the index of the chunk holding the i-th token.
+  size_t ChunkOfToken(size_t i) const;
+
+  // Appends the characters and tokens of the chunks after c, up to and
+  // including last, to chunk c and removes them.
+  void Merge(size_t c, size_t last);
+
+  // Splits chunk c into chunks of about chunk_size_ characters, at new lines.
+  void Split(size_t c);
+
+  // Merges chunk c into a neighbor if it has become too small, then splits
+  // the result if it has become too large. Returns the index of the first
+  // chunk whose start may have changed.
+  size_t Rebalance(size_t c);
+
+  // Recomputes the start and first token of the chunks from c on, as well as
+  // the size and token count of the document.
+  void Reindex(size_t c);
+
+  // Scans the characters in [begin, end) of a chunk's text, which must start
+  // and end on line boundaries, and appends their tokens to tokens.
+  void Scan(const std::string& text, size_t begin, size_t end,
+            std::vector<TokenValue>* tokens);
+
+  // Number of characters per chunk.
+  const size_t chunk_size_;
+
+  // Pool of identifier names.
+  StringInterner interner_;
+
+  // Chunks of the current document, in order. There is always at least one,
+  // and only the last one may be empty.
+  std::vector<Chunk> chunks_;
+
+  // Number of characters and tokens of the current document.
+  size_t size_;
+  size_t token_count_;
+};
+
+}  // namespace truplc
+
+#endif  // TRUPLC_SCANNER_INCREMENTAL_LEXER_H__
@@ -0,0 +1,178 @@
+// Perfect hash table of the keywords and word operators of TruPL. The scanner
+// reads every word as an identifier, then looks it up here to tell keywords,
+// "and" and "or" apart from plain identifiers. The hash function is chosen at
+// compile time so that no two words share a slot.
+// Copyright 2016 Hieu Le.
+
+#ifndef TRUPLC_SCANNER_KEYWORD_TABLE_H__
+#define TRUPLC_SCANNER_KEYWORD_TABLE_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "scanner/lexer_table.h"
+#include "tokens/add_operator_token.h"
+#include "tokens/keyword_token.h"
+#include "tokens/mul_operator_token.h"
+#include "tokens/token.h"
+#include "util/string_piece.h"
+
+namespace truplc {
+namespace internal {
+
+// Every keyword and word operator of TruPL.
+constexpr LexemeSpec kWordSpecs[] = {
+  {"program",   {TokenType::kKeyword,
+                 static_cast<int>(KeywordAttribute::kProgram)}},
+  {"procedure", {TokenType::kKeyword,
+                 static_cast<int>(KeywordAttribute::kProcedure)}},
+  {"int",       {TokenType::kKeyword,
+                 static_cast<int>(KeywordAttribute::kInt)}},
+  {"bool",      {TokenType::kKeyword,
+                 static_cast<int>(KeywordAttribute::kBool)}},
+  {"begin",     {TokenType::kKeyword,
+                 static_cast<int>(KeywordAttribute::kBegin)}},
+  {"end",       {TokenType::kKeyword,
+                 static_cast<int>(KeywordAttribute::kEnd)}},
+  {"if",        {TokenType::kKeyword,
+                 static_cast<int>(KeywordAttribute::kIf)}},
+  {"then",      {TokenType::kKeyword,
+                 static_cast<int>(KeywordAttribute::kThen)}},
+  {"else",      {TokenType::kKeyword,
+                 static_cast<int>(KeywordAttribute::kElse)}},
+  {"while",     {TokenType::kKeyword,
+                 static_cast<int>(KeywordAttribute::kWhile)}},
+  {"loop",      {TokenType::kKeyword,
+                 static_cast<int>(KeywordAttribute::kLoop)}},
+  {"print",     {TokenType::kKeyword,
+                 static_cast<int>(KeywordAttribute::kPrint)}},
+  {"not",       {TokenType::kKeyword,
+                 static_cast<int>(KeywordAttribute::kNot)}},
+  {"or",        {TokenType::kAddOperator,
+                 static_cast<int>(AddOperatorAttribute::kOr)}},
+  {"and",       {TokenType::kMulOperator,
+                 static_cast<int>(MulOperatorAttribute::kAnd)}},
+};
+
+// Number of bits of the hash, and so the number of slots in the table.
+const int kKeywordHashBits = 6;
+const int kKeywordSlots = 1 << kKeywordHashBits;
+
+// Length of the longest word the table can hold.
+const size_t kMaxKeywordLength = 15;
+
+// Hashes a word of at least two characters from its length and its first,
+// second and last characters with a multiplicative hash of given seed.
+constexpr uint32_t KeywordHash(const uint32_t seed, const char* word,
+                               const size_t length) {
+  return ((static_cast<uint32_t>(static_cast<unsigned char>(word[0]))
+           | static_cast<uint32_t>(static_cast<unsigned char>(word[1])) << 8
+           | static_cast<uint32_t>(
+               static_cast<unsigned char>(word[length - 1])) << 16
+           | static_cast<uint32_t>(length) << 24) * seed)
+      >> (32 - kKeywordHashBits);
+}
+
+// Returns the length of a null-terminated string.
+constexpr size_t ConstLength(const char* str) {
+  size_t length = 0;
+  while (str[length] != '\0') {
+    ++length;
+  }
+  return length;
+}
+
+struct KeywordSlot {
+  // Spelling of the word in this slot, or an empty string if the slot is
+  // free.
+  char word[kMaxKeywordLength + 1];
+
+  // Length of the word.
+  size_t length;
+
+  // Token for the word.
+  LexemeAction action;
+};
+
+struct KeywordTable {
+  // Multiplier of the hash function. Zero if no collision-free multiplier
+  // was found.
+  uint32_t seed;
+
+  // Shortest and longest word in the table.
+  size_t min_length;
+  size_t max_length;
+
+  // Slots indexed by the hash of their word.
+  KeywordSlot slots[kKeywordSlots];
+};
+
+// Checks if every word of kWordSpecs hashes to a distinct slot under a given
+// seed.
+constexpr bool IsPerfectKeywordSeed(const uint32_t seed) {
+  bool used[kKeywordSlots] = {};
+  for (const LexemeSpec& spec : kWordSpecs) {
+    const uint32_t slot =
+        KeywordHash(seed, spec.lexeme, ConstLength(spec.lexeme));
+    if (used[slot]) {
+      return false;
+    }
+    used[slot] = true;
+  }
+  return true;
+}
+
+// Searches for a perfect hash of kWordSpecs and fills the table.
+constexpr KeywordTable MakeKeywordTable() {
+  KeywordTable table = {};
+  table.min_length = kMaxKeywordLength;
+  for (uint32_t seed = 0x9E3779B1u; seed < 0x9E3779B1u + 2000; seed += 2) {
+    if (IsPerfectKeywordSeed(seed)) {
+      table.seed = seed;
+      break;
+    }
+  }
+  for (const LexemeSpec& spec : kWordSpecs) {
+    const size_t length = ConstLength(spec.lexeme);
+    KeywordSlot& slot = table.slots[KeywordHash(table.seed, spec.lexeme,
+                                                length)];
+    for (size_t i = 0; i < length && i < kMaxKeywordLength; ++i) {
+      slot.word[i] = spec.lexeme[i];
+    }
+    slot.length = length;
+    slot.action = spec.action;
+    table.min_length = length < table.min_length ? length : table.min_length;
+    table.max_length = length > table.max_length ? length : table.max_length;
+  }
+  return table;
+}
+
+constexpr KeywordTable kKeywordTable = MakeKeywordTable();
+
+static_assert(kKeywordTable.seed != 0,
+              "No perfect hash for the keywords; raise kKeywordHashBits.");
+static_assert(kKeywordTable.min_length >= 2,
+              "The keyword hash reads the first two characters of a word.");
+static_assert(kKeywordTable.max_length <= kMaxKeywordLength,
+              "Keyword too long; raise kMaxKeywordLength.");
+
+// Returns the token for a word: a keyword, a word operator, or an identifier
+// if the word is none of these.
+inline LexemeAction FindWord(const StringPiece word) {
+  if (word.size() >= kKeywordTable.min_length
+      && word.size() <= kKeywordTable.max_length) {
+    const KeywordSlot& slot = kKeywordTable.slots[
+        KeywordHash(kKeywordTable.seed, word.data(), word.size())];
+    if (slot.length == word.size()
+        && std::memcmp(slot.word, word.data(), word.size()) == 0) {
+      return slot.action;
+    }
+  }
+  return {TokenType::kIdentifier, 0};
+}
+
+}  // namespace internal
+}  // namespace truplc
+
+#endif  // TRUPLC_SCANNER_KEYWORD_TABLE_H__
@@ -0,0 +1,170 @@
+// Transition table of the deterministic finite automaton that recognizes the
+// lexemes of TruPL. The table is generated at compile time from a single
+// specification of the symbolic operators. Input bytes are first mapped to
+// equivalence classes, so each transition is one lookup into a small
+// states x classes array.
+// Copyright 2016 Hieu Le.
+
+#ifndef TRUPLC_SCANNER_LEXER_TABLE_H__
+#define TRUPLC_SCANNER_LEXER_TABLE_H__
+
+#include <cstdint>
+
+#include "scanner/buffer.h"
+#include "tokens/add_operator_token.h"
+#include "tokens/mul_operator_token.h"
+#include "tokens/punctuation_token.h"
+#include "tokens/rel_operator_token.h"
+#include "tokens/token.h"
+
+namespace truplc {
+namespace internal {
+
+// Token produced when the automaton stops in a given state. States that
+// accept nothing have type kUnspecified.
+struct LexemeAction {
+  TokenType type;
+  int attribute;
+};
+
+// A fixed lexeme of TruPL and the token it stands for.
+struct LexemeSpec {
+  const char* lexeme;
+  LexemeAction action;
+};
+
+// Every operator of TruPL spelled with symbols. Identifiers and numbers are
+// built into the automaton; keywords and word operators are told apart from
+// identifiers by the keyword table.
+constexpr LexemeSpec kOperatorSpecs[] = {
+  {";",         {TokenType::kPunctuation,
+                 static_cast<int>(PunctuationAttribute::kSemicolon)}},
+  {":",         {TokenType::kPunctuation,
+                 static_cast<int>(PunctuationAttribute::kColon)}},
+  {",",         {TokenType::kPunctuation,
+                 static_cast<int>(PunctuationAttribute::kComma)}},
+  {":=",        {TokenType::kPunctuation,
+                 static_cast<int>(PunctuationAttribute::kAssignment)}},
+  {"(",         {TokenType::kPunctuation,
+                 static_cast<int>(PunctuationAttribute::kOpenBracket)}},
+  {")",         {TokenType::kPunctuation,
+                 static_cast<int>(PunctuationAttribute::kCloseBracket)}},
+  {"=",         {TokenType::kRelOperator,
+                 static_cast<int>(RelOperatorAttribute::kEqual)}},
+  {"<>",        {TokenType::kRelOperator,
+                 static_cast<int>(RelOperatorAttribute::kNotEqual)}},
+  {">",         {TokenType::kRelOperator,
+                 static_cast<int>(RelOperatorAttribute::kGreaterThan)}},
+  {">=",        {TokenType::kRelOperator,
+                 static_cast<int>(RelOperatorAttribute::kGreaterOrEqual)}},
+  {"<",         {TokenType::kRelOperator,
+                 static_cast<int>(RelOperatorAttribute::kLessThan)}},
+  {"<=",        {TokenType::kRelOperator,
+                 static_cast<int>(RelOperatorAttribute::kLessOrEqual)}},
+  {"+",         {TokenType::kAddOperator,
+                 static_cast<int>(AddOperatorAttribute::kAdd)}},
+  {"-",         {TokenType::kAddOperator,
+                 static_cast<int>(AddOperatorAttribute::kSubtract)}},
+  {"*",         {TokenType::kMulOperator,
+                 static_cast<int>(MulOperatorAttribute::kMultiply)}},
+  {"/",         {TokenType::kMulOperator,
+                 static_cast<int>(MulOperatorAttribute::kDivide)}},
+};
+
+// Fixed states of the automaton. Every other state stands for a nonempty
+// prefix of some lexeme in kOperatorSpecs.
+const uint8_t kStartState      = 0;
+const uint8_t kIdentifierState = 1;
+const uint8_t kNumberState     = 2;
+
+// Transition target meaning that the automaton stops.
+const uint8_t kNoState = 0xFF;
+
+// Fixed byte classes. Every other class holds exactly one byte that appears
+// in kOperatorSpecs.
+const uint8_t kIllegalByteClass = 0;  // Outside the alphabet, including EOF.
+const uint8_t kSpaceByteClass   = 1;  // The delimiting space.
+const uint8_t kDigitByteClass   = 2;
+const uint8_t kLetterByteClass  = 3;
+
+// Capacity of the transition table.
+const int kMaxLexerStates = 32;
+const int kMaxByteClasses = 32;
+
+struct LexerTable {
+  // Equivalence class of every byte.
+  uint8_t byte_class[256];
+
+  // Next state indexed by current state and byte class, or kNoState.
+  uint8_t next[kMaxLexerStates][kMaxByteClasses];
+
+  // Token produced when the automaton stops in each state.
+  LexemeAction action[kMaxLexerStates];
+
+  // Number of states and byte classes in use.
+  int num_states;
+  int num_classes;
+};
+
+// Builds the transition table from kOperatorSpecs.
+constexpr LexerTable MakeLexerTable() {
+  LexerTable table = {};
+  for (int c = 0; c < 256; ++c) {
+    table.byte_class[c] = c >= 'a' && c <= 'z' ? kLetterByteClass
+        : c >= '0' && c <= '9' ? kDigitByteClass
+        : c == kSpace ? kSpaceByteClass : kIllegalByteClass;
+  }
+  table.num_classes = kLetterByteClass + 1;
+  for (const LexemeSpec& spec : kOperatorSpecs) {
+    for (const char* p = spec.lexeme; *p != '\0'; ++p) {
+      const unsigned char c = static_cast<unsigned char>(*p);
+      if (table.byte_class[c] == kIllegalByteClass) {
+        table.byte_class[c] = static_cast<uint8_t>(table.num_classes++);
+      }
+    }
+  }
+
+  for (int s = 0; s < kMaxLexerStates; ++s) {
+    for (int k = 0; k < kMaxByteClasses; ++k) {
+      table.next[s][k] = kNoState;
+    }
+    table.action[s] = {TokenType::kUnspecified, 0};
+  }
+  table.num_states = kNumberState + 1;
+
+  // Identifiers start with a letter and continue with letters and digits.
+  // Numbers are runs of digits.
+  table.next[kStartState][kLetterByteClass] = kIdentifierState;
+  table.next[kStartState][kDigitByteClass] = kNumberState;
+  table.next[kIdentifierState][kLetterByteClass] = kIdentifierState;
+  table.next[kIdentifierState][kDigitByteClass] = kIdentifierState;
+  table.next[kNumberState][kDigitByteClass] = kNumberState;
+  table.action[kIdentifierState] = {TokenType::kIdentifier, 0};
+  table.action[kNumberState] = {TokenType::kNumber, 0};
+
+  // Lay out the trie of all operators.
+  for (const LexemeSpec& spec : kOperatorSpecs) {
+    int state = kStartState;
+    for (const char* p = spec.lexeme; *p != '\0'; ++p) {
+      const uint8_t k = table.byte_class[static_cast<unsigned char>(*p)];
+      if (table.next[state][k] == kNoState) {
+        table.next[state][k] = static_cast<uint8_t>(table.num_states++);
+      }
+      state = table.next[state][k];
+    }
+    table.action[state] = spec.action;
+  }
+  return table;
+}
+
+constexpr LexerTable kLexerTable = MakeLexerTable();
+
+static_assert(kLexerTable.num_states <= kMaxLexerStates,
+              "Too many lexer states; raise kMaxLexerStates.");
+static_assert(kLexerTable.num_classes <= kMaxByteClasses,
+              "Too many byte classes; raise kMaxByteClasses.");
+
+}  // namespace internal
+}  // namespace truplc
+
+#endif  // TRUPLC_SCANNER_LEXER_TABLE_H__
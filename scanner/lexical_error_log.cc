@@ -0,0 +1,17 @@
+// Implementation for LexicalErrorLog class.
+// Copyright 2016 Hieu Le.
+
+#include "scanner/lexical_error_log.h"
+
+namespace truplc {
+
+const size_t LexicalErrorLog::kDefaultMaxErrors;
+
+LexicalErrorLog::LexicalErrorLog(const size_t max_errors)
+    : max_errors_(max_errors) {}
+
+void LexicalErrorLog::Record(const size_t offset, const std::string& message) {
+  errors_.push_back({offset, message});
+}
+
+}  // namespace truplc
@@ -0,0 +1,64 @@
+// Diagnostics collected by a scanner that recovers from lexical errors instead
+// of exiting. Errors only carry the offset of the offending character, which
+// SourceManager turns into a line and column when they are reported.
+// Copyright 2016 Hieu Le.
+
+#ifndef TRUPLC_SCANNER_LEXICAL_ERROR_LOG_H__
+#define TRUPLC_SCANNER_LEXICAL_ERROR_LOG_H__
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace truplc {
+
+// A lexical error found by the scanner.
+struct LexicalError {
+  // Offset of the offending character from the start of the input.
+  size_t offset;
+
+  // Description of the error, such as "Invalid character: @".
+  std::string message;
+};
+
+class LexicalErrorLog {
+ public:
+  // Number of errors after which scanning stops by default.
+  static const size_t kDefaultMaxErrors = 100;
+
+  // Constructs an empty log holding up to max_errors errors. A limit of 0
+  // means no limit.
+  explicit LexicalErrorLog(size_t max_errors = kDefaultMaxErrors);
+
+  // Records an error at a given offset. Must not be called once full.
+  void Record(size_t offset, const std::string& message);
+
+  // Checks if the error limit has been reached. The scanner returns the EOF
+  // token from then on.
+  bool full() const {
+    return max_errors_ != 0 && errors_.size() >= max_errors_;
+  }
+
+  // Returns the recorded errors, in input order.
+  const std::vector<LexicalError>& errors() const { return errors_; }
+
+  // Returns the number of recorded errors.
+  size_t size() const { return errors_.size(); }
+
+  // Checks if no error has been recorded.
+  bool empty() const { return errors_.empty(); }
+
+  // Returns the maximum number of errors, or 0 if there is no limit.
+  size_t max_errors() const { return max_errors_; }
+
+ private:
+  // Maximum number of errors, or 0 if there is no limit.
+  const size_t max_errors_;
+
+  // The recorded errors.
+  std::vector<LexicalError> errors_;
+};
+
+}  // namespace truplc
+
+#endif  // TRUPLC_SCANNER_LEXICAL_ERROR_LOG_H__
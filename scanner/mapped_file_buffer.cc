@@ -0,0 +1,16 @@
+// Implementation for MappedFileBuffer class.
+// Copyright 2016 Hieu Le.
+
+#include "scanner/mapped_file_buffer.h"
+
+namespace truplc {
+
+MappedFileBuffer::MappedFileBuffer(const std::string& filename)
+    : SourceFileMapping(filename),
+      MemoryBuffer(source_file_.data(), source_file_.size()) {
+  if (!mapped_) {  // Fail to map source file.
+    BufferFatalError("Error opening source file: " + filename);
+  }
+}
+
+}  // namespace truplc
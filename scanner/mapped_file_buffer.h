@@ -0,0 +1,42 @@
+// Buffer class to read characters from a memory-mapped input file.
+// Copyright 2016 Hieu Le.
+
+#ifndef TRUPLC_SCANNER_MAPPED_FILE_BUFFER_H__
+#define TRUPLC_SCANNER_MAPPED_FILE_BUFFER_H__
+
+#include <string>
+
+#include "scanner/memory_buffer.h"
+#include "util/mapped_file.h"
+
+namespace truplc {
+namespace internal {
+
+// Owns the mapping of a MappedFileBuffer. Kept as a base class so that the
+// file is mapped before the MemoryBuffer base starts reading it.
+class SourceFileMapping {
+ protected:
+  // Maps a given file. Failure is recorded in mapped_.
+  explicit SourceFileMapping(const std::string& filename)
+      : mapped_(source_file_.Open(filename)) {}
+
+  // The mapped source file.
+  MappedFile source_file_;
+
+  // Whether the source file was mapped successfully.
+  const bool mapped_;
+};
+
+}  // namespace internal
+
+class MappedFileBuffer : private internal::SourceFileMapping,
+                         public MemoryBuffer {
+ public:
+  // Maps the whole input program file into memory and initializes the buffer.
+  // The file must be a regular file; use FileBuffer for pipes and devices.
+  explicit MappedFileBuffer(const std::string& filename);
+};
+
+}  // namespace truplc
+
+#endif  // TRUPLC_SCANNER_MAPPED_FILE_BUFFER_H__
@@ -0,0 +1,88 @@
+// Implementation for MemoryBuffer class.
+// Copyright 2016 Hieu Le.
+
+#include "scanner/memory_buffer.h"
+
+#include <string>
+
+#include "scanner/char_search.h"
+#include "scanner/source_manager.h"
+
+namespace truplc {
+
+MemoryBuffer::MemoryBuffer(const char* data, const size_t size)
+    : MemoryBuffer(StringPiece(data, size), 0, size) {}
+
+MemoryBuffer::MemoryBuffer(const StringPiece text)
+    : MemoryBuffer(text, 0, text.size()) {}
+
+MemoryBuffer::MemoryBuffer(const StringPiece source, const size_t begin,
+                           const size_t end)
+    : source_(source),
+      cursor_(source.data() + begin),
+      end_(source.data() + end),
+      valid_end_(FindInvalidChar(cursor_, end_)),
+      mark_(cursor_),
+      space_start_(cursor_) {
+  // Remove any preceding whitespace or comment.
+  RemoveSpaceAndComment();
+}
+
+bool MemoryBuffer::RemoveSpaceAndComment() {
+  const char* start = cursor_;
+  while (cursor_ != end_) {
+    if (IsWhitespace(*cursor_)) {  // Remove whitespaces.
+      cursor_ = FindNonWhitespace(cursor_, end_);
+    } else if (*cursor_ == kCommentMarker) {  // Remove comments.
+      const char* new_line = FindNewLine(cursor_, end_);
+      cursor_ = new_line == end_ ? end_ : new_line + 1;
+    } else {
+      break;
+    }
+  }
+
+  if (cursor_ == start) {
+    return false;
+  }
+  space_start_ = start;
+  return true;
+}
+
+char MemoryBuffer::NextCharSlow() {
+  // Removes any subsequent region of whitespaces and comments and returns the
+  // default space delimiter.
+  if (RemoveSpaceAndComment()) {
+    return kSpace;
+  }
+
+  // Only reached at the end of input or right after an invalid character,
+  // which may have been skipped as part of a comment.
+  if (cursor_ >= valid_end_) {
+    if (cursor_ == end_) {
+      return kEOFMarker;
+    }
+    valid_end_ = FindInvalidChar(cursor_, end_);
+    // Flags error if current does not belong to the TruPL alphabet.
+    if (valid_end_ == cursor_) {
+      if (recover_invalid_chars_) {
+        ++cursor_;
+        return kInvalidMarker;
+      }
+      BufferFatalError(std::string("Invalid character: ") + *cursor_ +
+                       SourceManager(source_).Describe(cursor_ - source_.data()));
+    }
+  }
+  return *cursor_++;
+}
+
+void MemoryBuffer::UnreadChar(const char c) {
+  if (c == kEOFMarker) {
+    return;
+  }
+  // A delimiting space stands for a whole region of whitespaces and comments,
+  // so rewind to the start of that region. Any other character was read
+  // verbatim from memory.
+  cursor_ = c == kSpace ? space_start_ : cursor_ - 1;
+}
+
+}  // namespace truplc
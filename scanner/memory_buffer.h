@@ -0,0 +1,97 @@
+// Buffer class to read characters from a contiguous block of memory.
+// Copyright 2016 Hieu Le.
+
+#ifndef TRUPLC_SCANNER_MEMORY_BUFFER_H__
+#define TRUPLC_SCANNER_MEMORY_BUFFER_H__
+
+#include <cstddef>
+
+#include "scanner/buffer.h"
+#include "scanner/char_class.h"
+#include "util/string_piece.h"
+
+namespace truplc {
+
+class MemoryBuffer : public Buffer {
+ public:
+  // Initializes the buffer over size characters starting at data. The
+  // characters are not copied and must outlive the buffer.
+  MemoryBuffer(const char* data, size_t size);
+
+  // Initializes the buffer over a given text, which is not copied and must
+  // outlive the buffer.
+  explicit MemoryBuffer(StringPiece text);
+
+  // Initializes the buffer over the characters in [begin, end) of a source
+  // text, such as one chunk of a file scanned in parallel. Offsets, Text()
+  // and the locations in diagnostics refer to the whole source, which is not
+  // copied and must outlive the buffer.
+  MemoryBuffer(StringPiece source, size_t begin, size_t end);
+
+  // Removes and returns the next character from the buffer. Returns EOF if
+  // there is no more character to read from the buffer.
+  char NextChar() final {
+    // Fast path: a validated character that does not start a delimiter.
+    if (cursor_ < valid_end_) {
+      const char c = *cursor_;
+      if (!IsWhitespace(c) && c != kCommentMarker) {
+        ++cursor_;
+        return c;
+      }
+    }
+    return NextCharSlow();
+  }
+
+  // Places a character back into the buffer.
+  void UnreadChar(char c) final;
+
+  // Marks the start of a lexeme.
+  void Mark() final { mark_ = cursor_; }
+
+  // Returns a lexeme of given length from the underlying memory.
+  StringPiece Slice(const size_t length) const final {
+    return StringPiece(mark_, length);
+  }
+
+  // Returns the offset of the marked character from the start of the source.
+  size_t MarkOffset() const final { return mark_ - source_.data(); }
+
+  // Slices point into the underlying memory, which outlives the buffer.
+  bool HasStableSlices() const final { return true; }
+
+  // Returns the whole source the scanned characters are part of.
+  StringPiece Text() const final { return source_; }
+
+ private:
+  // Handles delimiters, the end of input and invalid characters for
+  // NextChar().
+  char NextCharSlow();
+
+  // Advances the cursor past any subsequent whitespace and comment.
+  // Returns true if any removal takes place; false otherwise.
+  bool RemoveSpaceAndComment();
+
+  // The whole source text, which starts at offset 0.
+  const StringPiece source_;
+
+  // Position of the next character to read.
+  const char* cursor_;
+
+  // One past the last character of the input.
+  const char* end_;
+
+  // Characters in [cursor_, valid_end_) are known to belong to the TruPL
+  // alphabet and need no further check when returned.
+  const char* valid_end_;
+
+  // Start of the lexeme being scanned.
+  const char* mark_;
+
+  // Start of the most recent region of whitespaces and comments that was
+  // compressed into a single space. Used to unread that space.
+  const char* space_start_;
+};
+
+}  // namespace truplc
+
+#endif  // TRUPLC_SCANNER_MEMORY_BUFFER_H__
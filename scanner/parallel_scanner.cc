@@ -0,0 +1,219 @@
+// Implementation for ParallelScanner class.
+// Copyright 2016 Hieu Le.
+
+#include "scanner/parallel_scanner.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <utility>
+
+#include "scanner/basic_scanner.h"
+#include "scanner/char_search.h"
+#include "scanner/lexical_error_log.h"
+#include "scanner/memory_buffer.h"
+#include "util/string_util.h"
+#include "util/text_colorizer.h"
+
+namespace truplc {
+namespace {
+
+// Expected number of characters per token, used to size the token vectors.
+const size_t kCharsPerToken = 8;
+
+// Number of chunks per thread. Having more chunks than threads balances the
+// load when some chunks take longer to scan than others.
+const size_t kChunksPerThread = 4;
+
+// Returns the number of threads to use for a requested count, where 0 stands
+// for one per hardware thread.
+size_t ThreadCount(const int num_threads) {
+  if (num_threads > 0) {
+    return num_threads;
+  }
+  return std::max(1u, std::thread::hardware_concurrency());
+}
+
+// Splits size characters at data into at most max_chunks chunks of at least
+// chunk_size characters each. Every chunk but the last ends right after a new
+// line. Returns the offsets at which the chunks start, followed by size.
+std::vector<size_t> SplitAtNewLines(const char* data, const size_t size,
+                                    const size_t max_chunks,
+                                    const size_t chunk_size) {
+  const size_t num_chunks =
+      std::max<size_t>(1, std::min(max_chunks, size / chunk_size));
+  std::vector<size_t> bounds(1, 0);
+  for (size_t i = 1; i < num_chunks; ++i) {
+    const size_t target = std::max(size / num_chunks * i, bounds.back());
+    const char* new_line = FindNewLine(data + target, data + size);
+    if (new_line == data + size) {
+      break;
+    }
+    const size_t bound = new_line + 1 - data;
+    if (bound > bounds.back() && bound < size) {
+      bounds.push_back(bound);
+    }
+  }
+  bounds.push_back(size);
+  return bounds;
+}
+
+// Tokens and number values of one chunk.
+struct Chunk {
+  std::vector<TokenValue> values;
+  std::vector<int64_t> numbers;
+};
+
+// Scans the characters of text in [begin, end) and appends their tokens to
+// a chunk, up to and including the EOF token. Offsets, as well as locations
+// in diagnostics, are relative to the start of text. Identifier names are
+// left for the caller to intern. If an error log is given, lexical errors are
+// recorded into it instead of exiting; scanning stops once it is full.
+void ScanChunk(const StringPiece text, const size_t begin, const size_t end,
+               LexicalErrorLog* errors, Chunk* chunk) {
+  BasicScanner<MemoryBuffer> scanner(
+      std::make_unique<MemoryBuffer>(text, begin, end));
+  if (errors != nullptr) {
+    scanner.EnableErrorRecovery(errors);
+  }
+  chunk->values.reserve((end - begin) / kCharsPerToken + 1);
+  TokenValue value;
+  do {
+    value = scanner.NextTokenValue();
+    chunk->values.push_back(value);
+    if (value.type == TokenType::kNumber) {
+      chunk->numbers.push_back(scanner.NumberValue());
+    }
+  } while (value.type != TokenType::kEOF);
+}
+
+}  // namespace
+
+ParallelScanner::ParallelScanner(const char* data, const size_t size,
+                                 const int num_threads,
+                                 const size_t chunk_size)
+    : data_(data),
+      size_(size),
+      next_(0),
+      next_number_(0),
+      number_(0),
+      arena_(nullptr) {
+  Tokenize(num_threads, chunk_size);
+}
+
+ParallelScanner::ParallelScanner(const std::string& filename,
+                                 const int num_threads,
+                                 const size_t chunk_size)
+    : data_(nullptr),
+      size_(0),
+      next_(0),
+      next_number_(0),
+      number_(0),
+      arena_(nullptr) {
+  if (!source_file_.Open(filename)) {
+    TextColorizer::Print(std::cerr, TextColorizer::kFGRedColorizer,
+                         StrCat("Exiting on Scanner Fatal Error: Error "
+                                "opening source file: ", filename, "\n"));
+    exit(EXIT_FAILURE);
+  }
+  data_ = source_file_.data();
+  size_ = source_file_.size();
+  Tokenize(num_threads, chunk_size);
+}
+
+void ParallelScanner::Tokenize(const int num_threads,
+                               const size_t chunk_size) {
+  const size_t threads = ThreadCount(num_threads);
+  const size_t max_chunks = threads == 1 ? 1 : threads * kChunksPerThread;
+  const std::vector<size_t> bounds = SplitAtNewLines(
+      data_, size_, max_chunks, std::max<size_t>(1, chunk_size));
+  const size_t num_chunks = bounds.size() - 1;
+
+  // Scan the chunks on a pool of threads, the calling one included, each
+  // taking the next chunk not yet scanned. Workers must not exit on an error,
+  // so each chunk records its first one instead.
+  const StringPiece text(data_, size_);
+  std::vector<Chunk> chunks(num_chunks);
+  std::vector<LexicalErrorLog> errors(num_chunks, LexicalErrorLog(1));
+  std::atomic<size_t> next_chunk(0);
+  const auto scan_chunks = [&text, &bounds, &chunks, &errors, &next_chunk] {
+    for (size_t i = next_chunk++; i < chunks.size(); i = next_chunk++) {
+      ScanChunk(text, bounds[i], bounds[i + 1], &errors[i], &chunks[i]);
+    }
+  };
+  std::vector<std::thread> workers;
+  for (size_t i = 1; i < std::min(threads, num_chunks); ++i) {
+    workers.emplace_back(scan_chunks);
+  }
+  scan_chunks();
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+
+  // A sequential scan exits on the first error of the text, which is the
+  // first error of the first chunk holding any. That chunk is scanned again
+  // without recovery, so that it exits with the same diagnostic.
+  for (size_t i = 0; i < num_chunks; ++i) {
+    if (!errors[i].empty()) {
+      Chunk chunk;
+      ScanChunk(text, bounds[i], bounds[i + 1], nullptr, &chunk);
+    }
+  }
+
+  // Identifiers are interned here, in order, so that they get the same ids
+  // as from a sequential scan.
+  for (Chunk& chunk : chunks) {
+    for (TokenValue& value : chunk.values) {
+      if (value.type == TokenType::kIdentifier) {
+        value.attribute = static_cast<int>(
+            interner_.Intern(StringPiece(data_ + value.offset, value.length)));
+      }
+    }
+  }
+
+  // Concatenate the chunks, keeping only the EOF token of the last one.
+  if (num_chunks == 1) {
+    values_ = std::move(chunks.front().values);
+    numbers_ = std::move(chunks.front().numbers);
+    return;
+  }
+  const TokenValue eof = chunks.back().values.back();
+  size_t total = 1;
+  size_t total_numbers = 0;
+  for (const Chunk& chunk : chunks) {
+    total += chunk.values.size() - 1;
+    total_numbers += chunk.numbers.size();
+  }
+  values_.reserve(total);
+  numbers_.reserve(total_numbers);
+  for (Chunk& chunk : chunks) {
+    values_.insert(values_.end(), chunk.values.begin(),
+                   chunk.values.end() - 1);
+    numbers_.insert(numbers_.end(), chunk.numbers.begin(),
+                    chunk.numbers.end());
+    chunk = Chunk();
+  }
+  values_.push_back(eof);
+}
+
+TokenValue ParallelScanner::NextTokenValue() {
+  const TokenValue& value = values_[next_];
+  if (next_ + 1 < values_.size()) {
+    ++next_;
+  }
+  lexeme_ = StringPiece(data_ + value.offset, value.length);
+  if (value.type == TokenType::kNumber) {
+    number_ = numbers_[next_number_++];
+  }
+  return value;
+}
+
+TokenHandle ParallelScanner::NextToken() {
+  const TokenValue value = NextTokenValue();
+  return internal::NewToken(value, lexeme_, number_, true, &interner_,
+                            arena_);
+}
+
+}  // namespace truplc
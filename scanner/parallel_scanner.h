@@ -0,0 +1,120 @@
+// Lexical analyzer that tokenizes a whole source text on several threads.
+// Comments end at a new line and no token spans one, so the text is split
+// into chunks right after new line characters and each chunk is scanned on
+// its own. The per-chunk tokens are then concatenated in order, which yields
+// the same stream as scanning the text with Scanner. Lexical errors are fatal
+// as with Scanner, and the one reported is the first of the text whichever
+// thread finds it.
+// Copyright 2016 Hieu Le.
+
+#ifndef TRUPLC_SCANNER_PARALLEL_SCANNER_H__
+#define TRUPLC_SCANNER_PARALLEL_SCANNER_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "tokens/token.h"
+#include "tokens/token_handle.h"
+#include "tokens/token_value.h"
+#include "util/arena.h"
+#include "util/mapped_file.h"
+#include "util/string_interner.h"
+#include "util/string_piece.h"
+
+namespace truplc {
+
+class ParallelScanner {
+ public:
+  // Default minimum number of characters per chunk. Smaller texts are not
+  // worth splitting.
+  static const size_t kDefaultChunkSize = 1 << 20;
+
+  // Tokenizes size characters starting at data. The characters are not
+  // copied and must outlive the scanner. Up to num_threads threads are used,
+  // or one per hardware thread if num_threads is 0. Chunks hold at least
+  // chunk_size characters, except for the last one.
+  ParallelScanner(const char* data, size_t size, int num_threads = 0,
+                  size_t chunk_size = kDefaultChunkSize);
+
+  // Maps and tokenizes a given regular file.
+  explicit ParallelScanner(const std::string& filename, int num_threads = 0,
+                           size_t chunk_size = kDefaultChunkSize);
+
+  ParallelScanner(const ParallelScanner&) = delete;
+  ParallelScanner& operator=(const ParallelScanner&) = delete;
+
+  // Returns all the tokens of the text as values, in order. The last value,
+  // and only that one, is the EOF token.
+  const std::vector<TokenValue>& values() const { return values_; }
+
+  // Returns the values of the number tokens of the text, in order.
+  const std::vector<int64_t>& numbers() const { return numbers_; }
+
+  // Returns the next token of the text as a value. The EOF token is returned
+  // repeatedly at the end of the text.
+  TokenValue NextTokenValue();
+
+  // Returns the lexeme of the token last returned by NextTokenValue(). The
+  // piece remains valid for the lifetime of the scanner.
+  StringPiece Lexeme() const { return lexeme_; }
+
+  // Returns the value of the number token last returned by NextTokenValue().
+  int64_t NumberValue() const { return number_; }
+
+  // Returns the pool in which identifier names are interned. Identifiers are
+  // interned in the order they appear, so their ids match those given by
+  // Scanner for the same text.
+  StringInterner* interner() { return &interner_; }
+
+  // Returns the next token of the text as a token object. Identifier and
+  // number tokens are allocated, refer to text owned by this scanner and must
+  // not outlive it; other tokens are shared instances.
+  TokenHandle NextToken();
+
+  // Makes NextToken() allocate identifier and number tokens in a given arena
+  // instead of the heap. The handles then do not own their tokens, which live
+  // as long as the arena and must not outlive this scanner either.
+  void UseArena(Arena* arena) { arena_ = arena; }
+
+ private:
+  // Splits the text into chunks, scans them on up to num_threads threads and
+  // concatenates the result into values_.
+  void Tokenize(int num_threads, size_t chunk_size);
+
+  // The source file, if the text is read from one.
+  MappedFile source_file_;
+
+  // The scanned text.
+  const char* data_;
+  size_t size_;
+
+  // Pool of identifier names.
+  StringInterner interner_;
+
+  // Tokens of the text, ending with the EOF token.
+  std::vector<TokenValue> values_;
+
+  // Values of the number tokens, in order.
+  std::vector<int64_t> numbers_;
+
+  // Index of the next token returned by NextTokenValue(), and of the next
+  // number value.
+  size_t next_;
+  size_t next_number_;
+
+  // Lexeme of the last returned token.
+  StringPiece lexeme_;
+
+  // Value of the last returned number token.
+  int64_t number_;
+
+  // Arena in which tokens are allocated, or null to allocate them on the heap.
+  Arena* arena_;
+};
+
+}  // namespace truplc
+
+#endif  // TRUPLC_SCANNER_PARALLEL_SCANNER_H__
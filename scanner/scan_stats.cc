@@ -0,0 +1,25 @@
+// Implementation for ScanStats class.
+// Copyright 2016 Hieu Le.
+
+#include "scanner/scan_stats.h"
+
+namespace truplc {
+
+ScanStats::ScanStats()
+    : tokens_(),
+      lexeme_bytes_(0),
+      bytes_read_(0),
+      pushbacks_(0),
+      refills_(0),
+      end_(0),
+      error_limit_reached_(false) {}
+
+uint64_t ScanStats::total_tokens() const {
+  uint64_t total = 0;
+  for (const uint64_t count : tokens_) {
+    total += count;
+  }
+  return total;
+}
+
+}  // namespace truplc
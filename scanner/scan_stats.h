@@ -0,0 +1,106 @@
+// Statistics on the work done by a scanner, for profiling the front end. The
+// whitespace and comments skipped are inferred from the offsets of the tokens,
+// so that counting is done once per token, outside the character loop. The
+// delimiters put back into the buffer are counted by the scanner itself.
+// Copyright 2016 Hieu Le.
+
+#ifndef TRUPLC_SCANNER_SCAN_STATS_H__
+#define TRUPLC_SCANNER_SCAN_STATS_H__
+
+#include <cstddef>
+#include <cstdint>
+
+#include "tokens/token.h"
+#include "tokens/token_value.h"
+
+namespace truplc {
+
+class ScanStats {
+ public:
+  // Number of token types counted, from kKeyword to kError.
+  static const size_t kNumTokenTypes =
+      static_cast<size_t>(TokenType::kError) + 1;
+
+  // Constructs statistics with all counters at zero.
+  ScanStats();
+
+  // Accounts for the next token scanned from the input. Tokens must be
+  // counted in input order, up to and including the first EOF token.
+  void Count(const TokenValue& value) {
+    const size_t type = static_cast<size_t>(value.type);
+    if (type < kNumTokenTypes) {
+      ++tokens_[type];
+    }
+    lexeme_bytes_ += value.length;
+    if (value.type != TokenType::kEOF) {
+      end_ = static_cast<uint64_t>(value.offset) + value.length;
+      return;
+    }
+    // The EOF token is at the end of input, past any trailing whitespace,
+    // unless the scan stopped at the error limit.
+    bytes_read_ = error_limit_reached_ ? end_ : value.offset;
+  }
+
+  // Accounts for a character put back into the buffer by UnreadChar().
+  void CountPushback() { ++pushbacks_; }
+
+  // Records that the scan stops short of the end of input, because the error
+  // limit was reached. The input is then read up to the last token only.
+  void CountErrorLimit() { error_limit_reached_ = true; }
+
+  // Sets the number of times the buffer was refilled from its source.
+  void set_refills(uint64_t refills) { refills_ = refills; }
+
+  // Returns the number of tokens of a given type.
+  uint64_t tokens(TokenType type) const {
+    const size_t index = static_cast<size_t>(type);
+    return index < kNumTokenTypes ? tokens_[index] : 0;
+  }
+
+  // Returns the number of tokens of all types, including the EOF token.
+  uint64_t total_tokens() const;
+
+  // Returns the number of characters read up to the EOF token, or 0 if it
+  // has not been counted yet. If the error limit was reached, this is the end
+  // of the last token before the EOF token.
+  uint64_t bytes_read() const { return bytes_read_; }
+
+  // Returns the number of whitespace and comment characters skipped between
+  // tokens, once the EOF token has been counted.
+  uint64_t skipped_bytes() const {
+    return bytes_read_ > lexeme_bytes_ ? bytes_read_ - lexeme_bytes_ : 0;
+  }
+
+  // Returns the number of characters put back into the buffer, including the
+  // EOF marker.
+  uint64_t pushbacks() const { return pushbacks_; }
+
+  // Returns the number of buffer refills.
+  uint64_t refills() const { return refills_; }
+
+ private:
+  // Number of tokens of each type.
+  uint64_t tokens_[kNumTokenTypes];
+
+  // Total length of the counted lexemes.
+  uint64_t lexeme_bytes_;
+
+  // End of the input read, once the EOF token has been counted.
+  uint64_t bytes_read_;
+
+  // Number of delimiters put back.
+  uint64_t pushbacks_;
+
+  // Number of buffer refills.
+  uint64_t refills_;
+
+  // Offset past the last counted token.
+  uint64_t end_;
+
+  // Whether the scan stopped at the error limit.
+  bool error_limit_reached_;
+};
+
+}  // namespace truplc
+
+#endif  // TRUPLC_SCANNER_SCAN_STATS_H__
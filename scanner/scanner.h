@@ -1,16 +1,25 @@
-// The direct-coded lexical analyzer for the TruPL compiler.
+// The direct-coded lexical analyzer for the TruPL compiler. Scanner picks the
+// BasicScanner specialization matching its buffer once, at construction, so
+// that only one virtual call is paid per token instead of per character.
 // Copyright 2016 Hieu Le.
 
 #ifndef TRUPLC_SCANNER_SCANNER_H__
 #define TRUPLC_SCANNER_SCANNER_H__
 
+#include <cstddef>
+#include <cstdint>
 #include <iostream>
 #include <memory>
 #include <string>
 
+#include "scanner/basic_scanner.h"
 #include "scanner/buffer.h"
+#include "scanner/lexical_error_log.h"
+#include "scanner/scan_stats.h"
+#include "scanner/source_manager.h"
 #include "tokens/add_operator_token.h"
 #include "tokens/eof_token.h"
+#include "tokens/error_token.h"
 #include "tokens/identifier_token.h"
 #include "tokens/keyword_token.h"
 #include "tokens/mul_operator_token.h"
@@ -18,27 +27,158 @@
 #include "tokens/punctuation_token.h"
 #include "tokens/rel_operator_token.h"
 #include "tokens/token.h"
+#include "tokens/token_handle.h"
+#include "tokens/token_stream.h"
+#include "tokens/token_value.h"
+#include "util/arena.h"
+#include "util/string_interner.h"
+#include "util/string_piece.h"
 
 namespace truplc {
+namespace internal {
+
+// Interface of the BasicScanner instantiations wrapped by Scanner.
+class ScannerInterface {
+ public:
+  virtual ~ScannerInterface();
+
+  // Returns the next token in the buffer as a value.
+  virtual TokenValue NextTokenValue() = 0;
+
+  // Appends the next tokens in the buffer to a stream. See
+  // BasicScanner::TokenizeInto().
+  virtual size_t TokenizeInto(TokenStream* stream, size_t max_tokens) = 0;
+
+  // Returns the lexeme of the token last returned by NextTokenValue().
+  virtual StringPiece Lexeme() const = 0;
+
+  // Returns the value of the number token last returned by NextTokenValue().
+  virtual int64_t NumberValue() const = 0;
+
+  // Returns the whole input if it is held in memory, or a piece with null
+  // data otherwise.
+  virtual StringPiece Text() const = 0;
+
+  // Returns the next token in the buffer.
+  virtual TokenHandle NextToken() = 0;
+
+  // Makes the scanner recover from lexical errors. See
+  // BasicScanner::EnableErrorRecovery().
+  virtual void EnableErrorRecovery(LexicalErrorLog* error_log) = 0;
+
+  // Makes the scanner allocate tokens in an arena. See
+  // BasicScanner::UseArena().
+  virtual void UseArena(Arena* arena) = 0;
+
+  // Returns the number of blocks the buffer has read from its source.
+  virtual size_t RefillCount() const = 0;
+
+  // Moves the wrapped BasicScanner into a scanner that counts every token
+  // into given statistics, and returns it. This scanner must be destroyed
+  // right after.
+  virtual std::unique_ptr<ScannerInterface> CountInto(ScanStats* stats) = 0;
+};
+
+}  // namespace internal
 
 class Scanner {
  public:
   // Constructs a Scanner for a given file.
   explicit Scanner(const std::string& filename);
 
-  // Constructs a Scanner as wrapper on a given buffer.
+  // Constructs a Scanner as wrapper on a given buffer. Memory and stream
+  // buffers, including their file-backed subclasses, are scanned without
+  // virtual calls per character.
   explicit Scanner(std::unique_ptr<Buffer> buffer);
 
-  // Returns the next token in this file.
-  std::unique_ptr<Token> NextToken();
+  // Constructs a Scanner over size characters of source text starting at
+  // data, such as a program received over the network. The characters are
+  // scanned in place without being copied, and must outlive the scanner.
+  Scanner(const char* data, size_t size);
+
+  ~Scanner();
+
+  // Returns the next token in this file as a value, without allocating.
+  TokenValue NextTokenValue();
+
+  // Appends the next tokens in this file to a stream, along with the values of
+  // number tokens, up to max_tokens of them or up to and including the EOF
+  // token, whichever comes first. Returns the number of tokens appended. Only
+  // one virtual call is paid per batch.
+  size_t TokenizeInto(TokenStream* stream, size_t max_tokens);
+
+  // Returns all the remaining tokens in this file, up to and including the
+  // EOF token.
+  TokenStream TokenizeAll();
+
+  // Returns the lexeme of the token last returned by NextTokenValue(). The
+  // piece remains valid until the next call to NextTokenValue().
+  StringPiece Lexeme() const;
+
+  // Returns the value of the number token last returned by NextTokenValue(),
+  // converted once while it was scanned.
+  int64_t NumberValue() const;
+
+  // Returns the pool in which this scanner interns identifier names. Token
+  // values of identifiers carry the id of their name in this pool as
+  // attribute. The pool lives as long as the scanner.
+  StringInterner* interner() { return &interner_; }
+
+  // Returns the next token in this file as a token object. Keyword,
+  // punctuation, operator and EOF tokens are shared instances; identifier,
+  // number and error tokens are allocated, may refer to source text owned by
+  // this scanner and must not outlive it.
+  TokenHandle NextToken();
+
+  // Returns the manager that maps token offsets to lines and columns, or null
+  // if the input is read as a stream and is not kept in memory.
+  const SourceManager* source_manager() const { return source_manager_.get(); }
+
+  // Makes this scanner recover from lexical errors instead of exiting. Each
+  // error is recorded and scanned as a kError token spanning the malformed
+  // input up to the next delimiter, or the integer literal too large for an
+  // int64_t. After max_errors errors, only the EOF token is returned; a limit
+  // of 0 means no limit.
+  void EnableErrorRecovery(
+      size_t max_errors = LexicalErrorLog::kDefaultMaxErrors);
+
+  // Makes this scanner allocate identifier, number and error tokens, and the
+  // lexemes they copy, in a given arena instead of the heap, such as an arena
+  // released once a compilation ends. The handles returned by NextToken() then
+  // do not own their tokens, which live as long as the arena and must not
+  // outlive this scanner either.
+  void UseArena(Arena* arena);
+
+  // Returns the lexical errors found so far, or null if error recovery is
+  // not enabled.
+  const LexicalErrorLog* error_log() const { return error_log_.get(); }
+
+  // Makes this scanner collect statistics on the tokens scanned from now on.
+  // Scanners without statistics count nothing: the counting scanner is only
+  // swapped in by this call.
+  void EnableStats();
+
+  // Returns the statistics collected so far, or all zeros if they are not
+  // enabled.
+  ScanStats stats() const;
 
  private:
-  // If a lexical error OR an internal scanner error occurs, call this method.
-  // It will print the message and exit.
-  void ScannerFatalError(const std::string& message) const;
+  // Pool of identifier names. Declared first so that it outlives scanner_.
+  StringInterner interner_;
+
+  // Lexical errors, if recovered from. Declared before scanner_ for the same
+  // reason.
+  std::unique_ptr<LexicalErrorLog> error_log_;
+
+  // Statistics on the scanned tokens, if enabled. Declared before scanner_
+  // for the same reason.
+  std::unique_ptr<ScanStats> stats_;
+
+  // The scanner specialized for the buffer.
+  std::unique_ptr<internal::ScannerInterface> scanner_;
 
-  // The character buffer.
-  std::unique_ptr<Buffer> buffer_;
+  // Locates tokens in the input, if held in memory.
+  std::unique_ptr<SourceManager> source_manager_;
 };
 
 }  // namespace truplc
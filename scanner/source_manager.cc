@@ -0,0 +1,61 @@
+// Implementation for SourceManager class.
+// Copyright 2016 Hieu Le.
+
+#include "scanner/source_manager.h"
+
+#include <algorithm>
+
+#include "scanner/char_search.h"
+#include "util/string_util.h"
+
+namespace truplc {
+
+SourceManager::SourceManager(const StringPiece text) : text_(text) {}
+
+void SourceManager::BuildLineIndex() const {
+  if (!line_starts_.empty()) {
+    return;
+  }
+  const char* const begin = text_.begin();
+  const char* const end = text_.end();
+  line_starts_.reserve(CountNewLines(begin, end) + 1);
+  line_starts_.push_back(0);
+  for (const char* new_line = FindNewLine(begin, end); new_line != end;
+       new_line = FindNewLine(new_line + 1, end)) {
+    line_starts_.push_back(static_cast<uint32_t>(new_line + 1 - begin));
+  }
+}
+
+SourceLocation SourceManager::Locate(size_t offset) const {
+  BuildLineIndex();
+  offset = std::min(offset, text_.size());
+  // The line is the last one starting at or before the offset.
+  const auto next_line = std::upper_bound(
+      line_starts_.begin(), line_starts_.end(), offset);
+  const uint32_t line = static_cast<uint32_t>(next_line - line_starts_.begin());
+  return {line, static_cast<uint32_t>(offset - line_starts_[line - 1] + 1)};
+}
+
+StringPiece SourceManager::Line(const uint32_t line) const {
+  BuildLineIndex();
+  const size_t start = line_starts_[line - 1];
+  const size_t end = line < line_starts_.size()
+      ? line_starts_[line] - 1 : text_.size();
+  return StringPiece(text_.data() + start, end - start);
+}
+
+uint32_t SourceManager::line_count() const {
+  BuildLineIndex();
+  // A final new line does not start a line of its own.
+  if (line_starts_.size() > 1 && line_starts_.back() == text_.size()) {
+    return static_cast<uint32_t>(line_starts_.size() - 1);
+  }
+  return static_cast<uint32_t>(line_starts_.size());
+}
+
+std::string SourceManager::Describe(const size_t offset) const {
+  const SourceLocation location = Locate(offset);
+  return Format(" at line %u, column %u", location.line, location.column);
+}
+
+}  // namespace truplc
@@ -0,0 +1,62 @@
+// Maps byte offsets in a source text to line and column numbers. Tokens only
+// carry the offset of their lexeme, so that the scanner never counts lines;
+// the table of line starts is built on the first lookup, which normally
+// happens only when a diagnostic is reported.
+// Copyright 2016 Hieu Le.
+
+#ifndef TRUPLC_SCANNER_SOURCE_MANAGER_H__
+#define TRUPLC_SCANNER_SOURCE_MANAGER_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "util/string_piece.h"
+
+namespace truplc {
+
+// Position of a character in a source text. Lines and columns count from 1;
+// columns count bytes.
+struct SourceLocation {
+  uint32_t line;
+  uint32_t column;
+};
+
+class SourceManager {
+ public:
+  // Constructs a manager for a given text, which is not copied and must
+  // outlive the manager.
+  explicit SourceManager(StringPiece text);
+
+  // Returns the location of the character at a given offset. An offset at or
+  // past the end of the text is located right after its last character.
+  SourceLocation Locate(size_t offset) const;
+
+  // Returns the text of a given line, without its new line character. line
+  // must be between 1 and line_count().
+  StringPiece Line(uint32_t line) const;
+
+  // Returns the number of lines in the text. A text that does not end with a
+  // new line still has its last line counted.
+  uint32_t line_count() const;
+
+  // Returns " at line L, column C" for the character at a given offset, to
+  // be appended to a diagnostic message.
+  std::string Describe(size_t offset) const;
+
+ private:
+  // Builds the table of line starts if it has not been built yet.
+  void BuildLineIndex() const;
+
+  // The source text.
+  const StringPiece text_;
+
+  // Offsets at which every line starts, in increasing order. Empty until the
+  // first lookup.
+  mutable std::vector<uint32_t> line_starts_;
+};
+
+}  // namespace truplc
+
+#endif  // TRUPLC_SCANNER_SOURCE_MANAGER_H__
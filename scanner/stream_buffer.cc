@@ -3,107 +3,175 @@
 
 #include "scanner/stream_buffer.h"
 
-#include <sstream>
+#include <algorithm>
+#include <cstring>
+#include <limits>
 #include <utility>
 
+#include "scanner/char_search.h"
+
 namespace truplc {
 namespace {
 
-// Checks if given input stream is empty.
-inline bool IsEmptyStream(std::istream* stream) {
-  return stream->peek() == EOF;
-}
-
-// Checks if given character represents a whitespace symbol. Whitespaces consist
-// of space (' '), tab ('\t') and new line ('\n') characters.
-inline bool IsWhitespace(char c) {
-  return c == kSpace || c == kTab || c == kNewLine;
-}
-
-// Fills buffer with characters from an input stream up to some specified limit.
-void FillBuffer(std::istream* stream, std::list<char>* buffer,
-                const size_t limit) {
-  for (size_t i = 0; i < limit && !IsEmptyStream(stream); ++i) {
-    buffer->push_back(stream->get());
-  }
-}
+// Value of StreamBuffer::mark_ when no lexeme is being scanned.
+const size_t kNoMark = std::numeric_limits<size_t>::max();
 
 }  // namespace
 
-StreamBuffer::StreamBuffer(std::istream* stream)
-    : stream_(stream), exhausted(false) {
+StreamBuffer::StreamBuffer(std::istream* stream, const size_t buffer_size)
+    : stream_(stream),
+      buffer_size_(buffer_size),
+      capacity_(buffer_size + 1),
+      buffer_(new char[buffer_size + 1]),
+      cursor_(1),
+      limit_(1),
+      valid_limit_(1),
+      mark_(kNoMark),
+      mark_limit_(kNoMark),
+      consumed_(0),
+      origin_(0),
+      mark_offset_(0),
+      refills_(0),
+      exhausted_(false) {
+  buffer_[0] = kSpace;
   // Remove any preceding whitespace or comment.
   RemoveSpaceAndComment();
 }
 
-char StreamBuffer::Next() {
-  // Refill buffer if empty.
-  if (buffer_.empty()) {
-    FillBuffer(stream_, &buffer_, kMaxBufferSize);
+bool StreamBuffer::Refill() {
+  if (exhausted_) {
+    return false;
   }
+
+  // Carry the lexeme being scanned over to the front of the buffer so that it
+  // stays contiguous. Its characters were already validated. The character
+  // preceding the new block must remain available to UnreadChar(): it is the
+  // last character of the lexeme unless a delimiter has followed the lexeme,
+  // in which case a free slot is left in between.
+  cursor_ = 1;
+  if (mark_ != kNoMark) {
+    const bool delimited = mark_limit_ != kNoMark;
+    const size_t carried = (delimited ? mark_limit_ : limit_) - mark_;
+    const size_t needed = 1 + carried + delimited + buffer_size_;
+    if (needed > capacity_) {
+      // Only a lexeme longer than the spare room makes the buffer grow.
+      capacity_ = std::max(2 * capacity_, needed);
+      std::unique_ptr<char[]> buffer(new char[capacity_]);
+      std::memcpy(&buffer[1], &buffer_[mark_], carried);
+      buffer_ = std::move(buffer);
+    } else {
+      std::memmove(&buffer_[1], &buffer_[mark_], carried);
+    }
+    mark_ = 1;
+    cursor_ += carried;
+    if (delimited) {
+      mark_limit_ = cursor_++;
+    }
+  }
+
+  stream_->read(&buffer_[cursor_], buffer_size_);
+  limit_ = cursor_ + static_cast<size_t>(stream_->gcount());
+  origin_ = consumed_ - cursor_;
+  consumed_ += limit_ - cursor_;
+
+  ValidateBlock();
+
   // Signal EOF if buffer is still empty after refill attempt.
-  if (buffer_.empty()) {
-    exhausted = true;
-    return kEOFMarker;
+  if (limit_ == cursor_) {
+    exhausted_ = true;
+    return false;
   }
+  ++refills_;
+  return true;
+}
 
-  char current = buffer_.front();
-  buffer_.pop_front();
-  return current;
+void StreamBuffer::ValidateBlock() {
+  const char* start = &buffer_[cursor_];
+  valid_limit_ = cursor_ + (FindInvalidChar(start, &buffer_[limit_]) - start);
 }
 
 void StreamBuffer::SkipLine() {
-  char current = Next();
-  while (current != kNewLine && !exhausted) {
-    current = Next();
-  }
+  do {
+    const char* start = &buffer_[cursor_];
+    const char* end = &buffer_[limit_];
+    const char* new_line = FindNewLine(start, end);
+    if (new_line != end) {
+      cursor_ += new_line - start + 1;
+      return;
+    }
+    cursor_ = limit_;
+  } while (Refill());
 }
 
 bool StreamBuffer::RemoveSpaceAndComment() {
-  char current = Next();
   bool hasWhitespaceOrComment = false;
-  while (IsWhitespace(current) || current == kCommentMarker) {
-    hasWhitespaceOrComment = true;
-    while (IsWhitespace(current)) {  // Remove whitespaces.
-      current = Next();
+  while (cursor_ != limit_ || Refill()) {
+    const char current = buffer_[cursor_];
+    if (!IsWhitespace(current) && current != kCommentMarker) {
+      break;
+    }
+    // A delimiter ends the marked lexeme.
+    if (mark_limit_ == kNoMark) {
+      mark_limit_ = cursor_;
     }
-    if (current == kCommentMarker) {  // Remove comments.
+    if (IsWhitespace(current)) {  // Remove whitespaces.
+      const char* start = &buffer_[cursor_];
+      cursor_ += FindNonWhitespace(start, &buffer_[limit_]) - start;
+    } else {  // Remove comments.
       SkipLine();
-      current = Next();
     }
+    hasWhitespaceOrComment = true;
   }
 
-  // current now stores the nearest character that is neither a whitespace
-  // nor part of a comment. If current is not EOF, places it back at the front
-  // of buffer.
-  if (!exhausted) {
-    buffer_.push_front(current);
-  }
+  // The cursor now rests on the nearest character that is neither a
+  // whitespace nor part of a comment, unless the stream is exhausted.
   return hasWhitespaceOrComment;
 }
 
-char StreamBuffer::NextChar() {
+char StreamBuffer::NextCharSlow() {
   // Removes any subsequent region of whitespaces and comments and returns the
   // default space delimiter.
   if (RemoveSpaceAndComment()) {
     return kSpace;
   }
 
-  char current = Next();
-  // Flags error if current does not belong to the TruPL alphabet.
-  if (!Validate(current)) {
-    if (!(current == kEOFMarker && exhausted)) {
-      BufferFatalError(std::string("Invalid character: ") + current);
+  // Only reached at the end of input or right after an invalid character,
+  // which may have been skipped as part of a comment.
+  if (cursor_ >= valid_limit_) {
+    if (cursor_ == limit_) {
+      return kEOFMarker;
+    }
+    ValidateBlock();
+    // Flags error if current does not belong to the TruPL alphabet.
+    if (valid_limit_ == cursor_) {
+      if (recover_invalid_chars_) {
+        ++cursor_;
+        return kInvalidMarker;
+      }
+      BufferFatalError(std::string("Invalid character: ") + buffer_[cursor_]);
     }
   }
-  return current;
+  return buffer_[cursor_++];
 }
 
 void StreamBuffer::UnreadChar(const char c) {
-  if (c != kEOFMarker) {
-    exhausted = false;
-    buffer_.push_front(c);
+  if (c == kEOFMarker) {
+    return;
   }
+  // The last returned character always sits right before the cursor. A
+  // delimiting space may stand for a whole region of whitespaces and comments
+  // that is no longer buffered, so a single space takes its place. An invalid
+  // character keeps its original value, so that it can still be sliced.
+  --cursor_;
+  if (c != kInvalidMarker) {
+    buffer_[cursor_] = c;
+  }
+}
+
+void StreamBuffer::Mark() {
+  mark_ = cursor_;
+  mark_limit_ = kNoMark;
+  mark_offset_ = origin_ + cursor_;
 }
 
 }  // namespace truplc
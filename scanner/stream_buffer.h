@@ -5,52 +5,128 @@
 #define TRUPLC_SCANNER_STREAM_BUFFER_H__
 
 #include <iostream>
-#include <list>
 #include <memory>
 #include <string>
 
 #include "scanner/buffer.h"
+#include "scanner/char_class.h"
+#include "util/string_piece.h"
 
 namespace truplc {
 
 class StreamBuffer : public Buffer {
  public:
-  // Initializes the buffer with specified input stream. The associated stream
-  // shall not be destroyed or modified during the lifetime of this object.
-  explicit StreamBuffer(std::istream* stream);
+  // Default capacity of internal character buffer.
+  static const size_t kMaxBufferSize = 1 << 16;
+
+  // Initializes the buffer with specified input stream and capacity. The
+  // associated stream shall not be destroyed or modified during the lifetime
+  // of this object. Capacity must be positive.
+  explicit StreamBuffer(std::istream* stream,
+                        size_t buffer_size = kMaxBufferSize);
 
   // Removes and returns the next character from the buffer. Returns EOF if
   // there is no more character to read from the buffer.
-  char NextChar() override;
+  char NextChar() final {
+    // Fast path: a validated character that does not start a delimiter.
+    if (cursor_ < valid_limit_) {
+      const char c = buffer_[cursor_];
+      if (!IsWhitespace(c) && c != kCommentMarker) {
+        ++cursor_;
+        return c;
+      }
+    }
+    return NextCharSlow();
+  }
 
   // Places a character back into the buffer.
-  void UnreadChar(char c) override;
+  void UnreadChar(char c) final;
+
+  // Marks the start of a lexeme. The buffer keeps the lexeme contiguous
+  // across refills, growing if the lexeme outgrows it.
+  void Mark() final;
+
+  // Returns a lexeme of given length from the buffer window.
+  StringPiece Slice(const size_t length) const final {
+    return StringPiece(&buffer_[mark_], length);
+  }
+
+  // Returns the offset of the marked character from the start of the stream.
+  size_t MarkOffset() const final { return mark_offset_; }
+
+  // Returns the number of non-empty blocks read from the stream.
+  size_t RefillCount() const final { return refills_; }
 
  private:
-  // Capacity of internal character buffer.
-  static const size_t kMaxBufferSize = 1024;
+  // Handles delimiters, refills, the end of input and invalid characters for
+  // NextChar().
+  char NextCharSlow();
 
-  // Gets the next character and performs any necessary buffer refill.
-  char Next();
+  // Refills the buffer with the next block of characters from the stream once
+  // every buffered character has been consumed. The marked lexeme, if any, is
+  // moved to the front of the buffer, followed by one free slot so that the
+  // last consumed character can still be unread. The new block is validated
+  // as a whole. Returns false if the stream has no more characters.
+  bool Refill();
+
+  // Validates the buffered characters from the cursor onward and advances
+  // valid_limit_ up to the first character outside the TruPL alphabet.
+  void ValidateBlock();
 
   // Skips the current line of characters.
   void SkipLine();
 
   // Removes any subsequent whitespace and comment. If there is any remaining
-  // token to process, the first character of that token would be stored in
-  // the buffer's front.
+  // token to process, the cursor is left on the first character of that token.
   // Returns true if any removal takes place; false otherwise.
   bool RemoveSpaceAndComment();
 
   // Input stream to read characters from.
   std::istream* stream_;
 
-  // Internal character buffer.
-  std::list<char> buffer_;
+  // Number of characters read from the stream per refill.
+  const size_t buffer_size_;
+
+  // Number of slots in the internal character buffer.
+  size_t capacity_;
+
+  // Internal character buffer. Holds the carried-over lexeme, one slot for
+  // the character preceding the current block, and the block itself.
+  std::unique_ptr<char[]> buffer_;
+
+  // Index of the next character to read.
+  size_t cursor_;
+
+  // One past the index of the last valid character.
+  size_t limit_;
+
+  // Characters in [cursor_, valid_limit_) are known to belong to the TruPL
+  // alphabet and need no further check when returned.
+  size_t valid_limit_;
+
+  // Index of the start of the lexeme being scanned.
+  size_t mark_;
+
+  // One past the index of the last character of the marked lexeme, once the
+  // delimiter following it has been reached.
+  size_t mark_limit_;
+
+  // Number of characters read from the stream so far.
+  size_t consumed_;
+
+  // Offset in the stream of the character that index 0 of the buffer would
+  // hold if the current block extended to the front of the buffer. Carried
+  // characters do not follow it. Computed modulo the range of size_t.
+  size_t origin_;
+
+  // Offset in the stream of the start of the marked lexeme.
+  size_t mark_offset_;
+
+  // Number of non-empty blocks read from the stream.
+  size_t refills_;
 
   // Flags indicating if EOF has been reached.
-  // TODO(hieule): Remove this.
-  bool exhausted;
+  bool exhausted_;
 };
 
 }  // namespace truplc
@@ -0,0 +1,268 @@
+// Implementation for TokenCache class.
+// Copyright 2016 Hieu Le.
+
+#include "scanner/token_cache.h"
+
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+#include "tokens/token_registry.h"
+#include "util/hash.h"
+#include "util/mapped_file.h"
+#include "util/string_util.h"
+
+namespace truplc {
+namespace {
+
+// Leading bytes of every cache file.
+const char kMagic[8] = {'T', 'R', 'U', 'P', 'L', 'T', 'O', 'K'};
+
+// Fixed-size start of a cache file. It is followed by the arrays of token
+// types, attributes, offsets and lengths, by the values of the number tokens,
+// then by the arrays of name lengths and name characters. Every array starts
+// at a multiple of 4 bytes. All fields are in the byte order of the machine
+// that wrote the file.
+struct CacheHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t name_count;
+  uint64_t source_hash;
+  uint64_t source_size;
+  uint64_t token_count;
+  uint64_t number_count;
+  uint64_t name_bytes;
+};
+
+// Rounds a size up to a multiple of 4.
+size_t Align4(const size_t size) {
+  return (size + 3) & ~size_t{3};
+}
+
+// Returns the size of a cache file with a given header.
+size_t FileSize(const CacheHeader& header) {
+  return sizeof(CacheHeader) + Align4(header.token_count) +
+         3 * 4 * header.token_count + 8 * header.number_count +
+         4 * size_t{header.name_count} + header.name_bytes;
+}
+
+// Appends the bytes of an array of n values to a string.
+template <typename T>
+void AppendArray(const T* values, const size_t n, std::string* out) {
+  out->append(reinterpret_cast<const char*>(values), n * sizeof(T));
+}
+
+// Returns the i-th value of type T from an array in a cache file.
+template <typename T>
+T Load(const char* const array, const size_t i) {
+  T value;
+  std::memcpy(&value, array + i * sizeof(T), sizeof(T));
+  return value;
+}
+
+}  // namespace
+
+const uint32_t TokenCache::kVersion;
+
+TokenCache::TokenCache(const std::string& directory)
+    : directory_(directory), hits_(0), misses_(0) {}
+
+std::string TokenCache::PathFor(const StringPiece text) const {
+  return PathForHash(Hash64(text.data(), text.size()));
+}
+
+std::string TokenCache::PathForHash(const uint64_t hash) const {
+  return Format("%s/%016llx.tok", directory_.c_str(),
+                static_cast<unsigned long long>(hash));  // NOLINT
+}
+
+bool TokenCache::Lookup(const StringPiece text, TokenStream* const stream,
+                        StringInterner* const interner) {
+  if (!Replay(text, stream, interner)) {
+    ++misses_;
+    return false;
+  }
+  ++hits_;
+  return true;
+}
+
+bool TokenCache::Replay(const StringPiece text, TokenStream* const stream,
+                        StringInterner* const interner) const {
+  const uint64_t hash = Hash64(text.data(), text.size());
+  MappedFile file;
+  CacheHeader header;
+  if (interner->size() != 0 || !file.Open(PathForHash(hash)) ||
+      file.size() < sizeof(header)) {
+    return false;
+  }
+  std::memcpy(&header, file.data(), sizeof(header));
+  // Only the hash and size of the source are compared, so a file written for
+  // another text with the same hash is not detected. Every value read from
+  // the file is checked instead, so that a stale, truncated or corrupt file
+  // can never replay tokens outside the text or names the interner lacks.
+  if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 ||
+      header.version != kVersion ||
+      header.source_hash != hash ||
+      header.source_size != text.size() ||
+      header.token_count == 0 ||
+      header.token_count > file.size() || header.number_count > file.size() ||
+      header.name_bytes > file.size() ||
+      file.size() != FileSize(header)) {
+    return false;
+  }
+
+  const size_t count = header.token_count;
+  const char* const types = file.data() + sizeof(header);
+  const char* const attributes = types + Align4(count);
+  const char* const offsets = attributes + 4 * count;
+  const char* const lengths = offsets + 4 * count;
+  const char* const numbers = lengths + 4 * count;
+  size_t number_count = 0;
+  for (size_t i = 0; i < count; ++i) {
+    const uint8_t type = Load<uint8_t>(types, i);
+    const int32_t attribute = Load<int32_t>(attributes, i);
+    const uint64_t end = uint64_t{Load<uint32_t>(offsets, i)} +
+                         Load<uint32_t>(lengths, i);
+    // The stream holds one kEOF token, which is its last.
+    if (type > static_cast<uint8_t>(TokenType::kError) ||
+        (type == static_cast<uint8_t>(TokenType::kEOF)) != (i == count - 1) ||
+        end > text.size()) {
+      return false;
+    }
+    switch (static_cast<TokenType>(type)) {
+      case TokenType::kIdentifier:
+        if (attribute < 0 ||
+            static_cast<uint32_t>(attribute) >= header.name_count) {
+          return false;
+        }
+        break;
+      case TokenType::kNumber:
+        ++number_count;
+        break;
+      case TokenType::kError:
+        // The index of the error in a log that is not cached.
+        if (attribute < 0) {
+          return false;
+        }
+        break;
+      default:
+        // Keywords, punctuation, operators and EOF are shared tokens, which
+        // must exist for their attribute.
+        if (FindSharedToken(static_cast<TokenType>(type), attribute) ==
+            nullptr) {
+          return false;
+        }
+        break;
+    }
+  }
+  if (number_count != header.number_count) {
+    return false;
+  }
+
+  const char* const name_lengths = numbers + 8 * number_count;
+  const char* name = name_lengths + 4 * size_t{header.name_count};
+  uint64_t name_bytes = 0;
+  for (size_t i = 0; i < header.name_count; ++i) {
+    name_bytes += Load<uint32_t>(name_lengths, i);
+  }
+  if (name_bytes != header.name_bytes) {
+    return false;
+  }
+  for (size_t i = 0; i < header.name_count; ++i) {
+    const uint32_t length = Load<uint32_t>(name_lengths, i);
+    // A repeated name would shift the ids of the names after it.
+    if (interner->Intern(StringPiece(name, length)) != i) {
+      interner->Clear();
+      return false;
+    }
+    name += length;
+  }
+
+  stream->clear();
+  stream->reserve(count);
+  size_t k = 0;
+  for (size_t i = 0; i < count; ++i) {
+    const TokenValue value = {static_cast<TokenType>(Load<uint8_t>(types, i)),
+                              Load<int32_t>(attributes, i),
+                              Load<uint32_t>(offsets, i),
+                              Load<uint32_t>(lengths, i)};
+    if (value.type == TokenType::kNumber) {
+      stream->push_back(value, Load<int64_t>(numbers, k++));
+    } else {
+      stream->push_back(value);
+    }
+  }
+  return true;
+}
+
+bool TokenCache::Store(const StringPiece text, const TokenStream& stream,
+                       const StringInterner& interner) const {
+  CacheHeader header;
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kVersion;
+  header.name_count = static_cast<uint32_t>(interner.size());
+  header.source_hash = Hash64(text.data(), text.size());
+  header.source_size = text.size();
+  header.token_count = stream.size();
+  header.number_count = stream.number_count();
+  header.name_bytes = 0;
+  for (StringInterner::Id id = 0; id < interner.size(); ++id) {
+    header.name_bytes += interner.Lookup(id).size();
+  }
+
+  const size_t count = stream.size();
+  std::vector<uint8_t> types(Align4(count));
+  std::vector<int32_t> attributes(count);
+  std::vector<uint32_t> offsets(count);
+  std::vector<uint32_t> lengths(count);
+  for (size_t i = 0; i < count; ++i) {
+    types[i] = static_cast<uint8_t>(stream.type(i));
+    attributes[i] = stream.attribute(i);
+    offsets[i] = stream.offset(i);
+    lengths[i] = stream.length(i);
+  }
+  std::vector<int64_t> numbers(stream.number_count());
+  for (size_t k = 0; k < numbers.size(); ++k) {
+    numbers[k] = stream.number(k);
+  }
+  std::vector<uint32_t> name_lengths(interner.size());
+  for (StringInterner::Id id = 0; id < interner.size(); ++id) {
+    name_lengths[id] = static_cast<uint32_t>(interner.Lookup(id).size());
+  }
+
+  std::string image;
+  image.reserve(FileSize(header));
+  AppendArray(&header, 1, &image);
+  AppendArray(types.data(), types.size(), &image);
+  AppendArray(attributes.data(), count, &image);
+  AppendArray(offsets.data(), count, &image);
+  AppendArray(lengths.data(), count, &image);
+  AppendArray(numbers.data(), numbers.size(), &image);
+  AppendArray(name_lengths.data(), name_lengths.size(), &image);
+  for (StringInterner::Id id = 0; id < interner.size(); ++id) {
+    const StringPiece name = interner.Lookup(id);
+    image.append(name.data(), name.size());
+  }
+
+  const std::string path = PathForHash(header.source_hash);
+  const std::string temporary_path = Format("%s.%d", path.c_str(), getpid());
+  {
+    std::ofstream file(temporary_path, std::ios::binary | std::ios::trunc);
+    file.write(image.data(), image.size());
+    file.close();
+    if (!file) {
+      std::remove(temporary_path.c_str());
+      return false;
+    }
+  }
+  if (std::rename(temporary_path.c_str(), path.c_str()) != 0) {
+    std::remove(temporary_path.c_str());
+    return false;
+  }
+  return true;
+}
+
+}  // namespace truplc
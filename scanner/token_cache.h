@@ -0,0 +1,74 @@
+// On-disk cache of scanned token streams, keyed by a hash of the source text.
+// A cache file holds the token values, the number values and the interned
+// identifier names of one source text, laid out as flat arrays that are
+// memory-mapped and copied back into a TokenStream without running the
+// scanner.
+// Copyright 2016 Hieu Le.
+
+#ifndef TRUPLC_SCANNER_TOKEN_CACHE_H__
+#define TRUPLC_SCANNER_TOKEN_CACHE_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "tokens/token_stream.h"
+#include "util/string_interner.h"
+#include "util/string_piece.h"
+
+namespace truplc {
+
+class TokenCache {
+ public:
+  // Version of the cache file format. Files of any other version are
+  // ignored. Must be bumped whenever the layout, or the token values produced
+  // by the scanner for a given text, change.
+  static const uint32_t kVersion = 3;
+
+  // Constructs a cache storing its files in a given directory, which must
+  // exist.
+  explicit TokenCache(const std::string& directory);
+
+  // Looks up the tokens of a given source text. On a hit, replaces the
+  // content of stream with the cached tokens, interns the cached identifier
+  // names into interner, which must be empty, and returns true. Returns false,
+  // leaving stream and interner unchanged, if there is no valid cache file for
+  // the text or if interner is not empty.
+  bool Lookup(StringPiece text, TokenStream* stream,
+              StringInterner* interner);
+
+  // Stores the tokens of a given source text, scanned with identifier names
+  // interned into interner. Returns false if the cache file cannot be
+  // written. The file is written under a temporary name and renamed, so that
+  // concurrent readers never see a partial file.
+  bool Store(StringPiece text, const TokenStream& stream,
+             const StringInterner& interner) const;
+
+  // Returns the path of the cache file for a given source text.
+  std::string PathFor(StringPiece text) const;
+
+  // Returns the number of lookups that found a valid cache file.
+  size_t hits() const { return hits_; }
+
+  // Returns the number of lookups that did not.
+  size_t misses() const { return misses_; }
+
+ private:
+  // Implements Lookup() without counting the result.
+  bool Replay(StringPiece text, TokenStream* stream,
+              StringInterner* interner) const;
+
+  // Returns the path of the cache file for a source text with a given hash.
+  std::string PathForHash(uint64_t hash) const;
+
+  // Directory holding the cache files.
+  const std::string directory_;
+
+  // Lookup counters.
+  size_t hits_;
+  size_t misses_;
+};
+
+}  // namespace truplc
+
+#endif  // TRUPLC_SCANNER_TOKEN_CACHE_H__
@@ -0,0 +1,118 @@
+// Unit tests for LookaheadRing class.
+// Copyright 2016 Hieu Le.
+
+#include "parser/internal/lookahead_ring.h"
+
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "scanner/stream_buffer.h"
+
+#include "gtest/gtest.h"
+
+namespace truplc {
+namespace internal {
+namespace {
+
+// Returns all token values of a program, including the EOF token.
+std::vector<TokenValue> ScanAll(const std::string& program) {
+  std::istringstream stream(program);
+  Scanner scanner(std::make_unique<StreamBuffer>(&stream));
+  std::vector<TokenValue> values;
+  do {
+    values.push_back(scanner.NextTokenValue());
+  } while (values.back().type != TokenType::kEOF);
+  return values;
+}
+
+// Builds a program of many statements, long enough to wrap around the ring.
+std::string LongProgram() {
+  std::string program;
+  for (int i = 0; i < 40; ++i) {
+    program += "a := b + 12; ";
+  }
+  return program;
+}
+
+TEST(LookaheadRingTest, ConsumeAll) {
+  const std::string program = LongProgram();
+  const std::vector<TokenValue> expected = ScanAll(program);
+  std::istringstream stream(program);
+  Scanner scanner(std::make_unique<StreamBuffer>(&stream));
+  LookaheadRing ring(&scanner);
+  for (const TokenValue& value : expected) {
+    EXPECT_EQ(ring.Current(), value);
+    ring.Consume();
+  }
+  // The EOF token stays once reached.
+  EXPECT_EQ(ring.Current(), expected.back());
+  ring.Consume();
+  EXPECT_EQ(ring.Current(), expected.back());
+}
+
+TEST(LookaheadRingTest, Peek) {
+  const std::string program = LongProgram();
+  const std::vector<TokenValue> expected = ScanAll(program);
+  std::istringstream stream(program);
+  Scanner scanner(std::make_unique<StreamBuffer>(&stream));
+  LookaheadRing ring(&scanner);
+  for (size_t i = 0; i < expected.size(); ++i) {
+    for (size_t k = 0; k < LookaheadRing::kCapacity; ++k) {
+      const size_t j = std::min(i + k, expected.size() - 1);
+      ASSERT_EQ(ring.Peek(k), expected[j]) << "i=" << i << " k=" << k;
+    }
+    ring.Consume();
+  }
+}
+
+TEST(LookaheadRingTest, PeekPastEndAfterConsume) {
+  // 32 tokens and EOF: after a few tokens are consumed, the refill for a far
+  // peek stops at EOF, short of the slot asked for.
+  std::string program;
+  for (int i = 0; i < 8; ++i) {
+    program += "a := b; ";
+  }
+  const std::vector<TokenValue> expected = ScanAll(program);
+  ASSERT_EQ(expected.size(), LookaheadRing::kCapacity + 1);
+  for (size_t consumed = 1; consumed < 5; ++consumed) {
+    std::istringstream stream(program);
+    Scanner scanner(std::make_unique<StreamBuffer>(&stream));
+    LookaheadRing ring(&scanner);
+    for (size_t i = 0; i < consumed; ++i) {
+      ring.Consume();
+    }
+    EXPECT_EQ(ring.Peek(LookaheadRing::kCapacity - 1), expected.back())
+        << "consumed=" << consumed;
+    EXPECT_EQ(ring.Peek(0), expected[consumed]);
+  }
+}
+
+TEST(LookaheadRingTest, NewToken) {
+  std::istringstream stream("x := 12345");
+  Scanner scanner(std::make_unique<StreamBuffer>(&stream, 4));
+  LookaheadRing ring(&scanner);
+  EXPECT_EQ(ring.NewToken()->DebugString(), "kIdentifier:x");
+  EXPECT_EQ(ring.NewToken(2)->DebugString(), "kNumber:12345");
+  EXPECT_EQ(ring.NewToken(5)->DebugString(), "kEOF:EndOfFile");
+  ring.Consume();
+  EXPECT_EQ(ring.NewToken(1)->DebugString(), "kNumber:12345");
+}
+
+TEST(LookaheadRingTest, NewNumberTokenAfterBatch) {
+  // The whole input is scanned in one batch, after which the stream buffer
+  // no longer holds the digits.
+  std::istringstream stream("a := 007 + 0 + 12");
+  Scanner scanner(std::make_unique<StreamBuffer>(&stream, 4));
+  LookaheadRing ring(&scanner);
+  EXPECT_EQ(ring.Peek(6).type, TokenType::kNumber);
+  EXPECT_EQ(ring.NewToken(2)->DebugString(), "kNumber:007");
+  EXPECT_EQ(ring.NewToken(4)->DebugString(), "kNumber:0");
+  EXPECT_EQ(ring.NewToken(6)->DebugString(), "kNumber:12");
+  EXPECT_EQ(static_cast<const NumberToken&>(*ring.NewToken(2)).GetValue(), 7);
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace truplc
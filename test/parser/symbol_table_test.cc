@@ -3,6 +3,8 @@
 
 #include "parser/symbol_table.h"
 
+#include <string>
+
 #include "gtest/gtest.h"
 
 namespace truplc {
@@ -85,6 +87,74 @@ TEST(SymbolTableTest, GetFormalParamType) {
   EXPECT_EQ(table.GetType(procedure, 1), ExpressionType::kGarbage);
 }
 
+TEST(SymbolTableTest, InternedNames) {
+  StringInterner interner;
+  const StringInterner::Id foo = interner.Intern(std::string("foo"));
+  const StringInterner::Id main = interner.Intern(std::string("main"));
+  SymbolTable table(&interner);
+  table.Install(foo, main, ExpressionType::kInt);
+  table.Install(interner.Intern(std::string("bar")), foo,
+                ExpressionType::kBool, 0);
+
+  EXPECT_TRUE(table.IsDeclared(foo, main));
+  EXPECT_FALSE(table.IsDeclared(main, foo));
+  EXPECT_EQ(table.GetType(foo, main), ExpressionType::kInt);
+  EXPECT_EQ(table.GetType(foo, 0), ExpressionType::kBool);
+
+  // Names given as strings resolve through the same pool.
+  EXPECT_TRUE(table.IsDeclared("bar", "foo"));
+  table.Install("baz", "main", ExpressionType::kBool);
+  EXPECT_EQ(table.GetType(interner.Find(std::string("baz")), main),
+            ExpressionType::kBool);
+  EXPECT_EQ(interner.size(), 4u);
+}
+
+TEST(SymbolTableTest, FirstInstallationWins) {
+  SymbolTable table;
+  table.Install("foo", "main", ExpressionType::kInt);
+  table.Install("foo", "main", ExpressionType::kBool);
+  table.Install("bar", "main::baz", ExpressionType::kInt, 1);
+  table.Install("quoz", "main::baz", ExpressionType::kBool, 1);
+
+  EXPECT_EQ(table.GetType("foo", "main"), ExpressionType::kInt);
+  EXPECT_EQ(table.GetType("main::baz", 1), ExpressionType::kInt);
+}
+
+TEST(SymbolTableTest, UpdateTypeOnlyOnce) {
+  SymbolTable table;
+  table.Install("foo", "main", ExpressionType::kUnknown);
+  table.UpdateType(ExpressionType::kUnknown);
+  table.UpdateType(ExpressionType::kInt);
+  table.Install("bar", "main", ExpressionType::kUnknown);
+  table.UpdateType(ExpressionType::kBool);
+
+  EXPECT_EQ(table.GetType("foo", "main"), ExpressionType::kInt);
+  EXPECT_EQ(table.GetType("bar", "main"), ExpressionType::kBool);
+}
+
+TEST(SymbolTableTest, ManyEntries) {
+  const int kNumEntries = 10000;
+  StringInterner interner;
+  SymbolTable table(&interner);
+  const StringInterner::Id procedure = interner.Intern(std::string("main"));
+  for (int i = 0; i < kNumEntries; ++i) {
+    const StringInterner::Id id = interner.Intern(std::to_string(i));
+    table.Install(id, procedure,
+                  i % 2 == 0 ? ExpressionType::kInt : ExpressionType::kBool,
+                  i);
+  }
+  for (int i = 0; i < kNumEntries; ++i) {
+    const ExpressionType type =
+        i % 2 == 0 ? ExpressionType::kInt : ExpressionType::kBool;
+    const StringInterner::Id id = interner.Find(std::to_string(i));
+    EXPECT_TRUE(table.IsDeclared(id, procedure));
+    EXPECT_FALSE(table.IsDeclared(procedure, id));
+    EXPECT_EQ(table.GetType(id, procedure), type);
+    EXPECT_EQ(table.GetType(procedure, i), type);
+  }
+  EXPECT_EQ(table.GetType(procedure, kNumEntries), ExpressionType::kGarbage);
+}
+
 TEST(SymbolTableTest, Dump) {
   SymbolTable table;
   EXPECT_EQ(table.Dump(), "Content of symbol table:");
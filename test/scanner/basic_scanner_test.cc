@@ -0,0 +1,228 @@
+// Unit tests for BasicScanner class template.
+// Copyright 2016 Hieu Le.
+
+#include "scanner/basic_scanner.h"
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "scanner/lexical_error_log.h"
+#include "tokens/add_operator_token.h"
+#include "tokens/identifier_token.h"
+#include "tokens/keyword_token.h"
+#include "tokens/punctuation_token.h"
+#include "tokens/token_value.h"
+#include "util/string_interner.h"
+
+#include "gtest/gtest.h"
+
+namespace truplc {
+namespace {
+
+const char kProgram[] =
+    "program foo;\n"
+    "  a, b: int; # Variables.\n"
+    "  procedure bar(x: bool) begin print x; end;\n"
+    "begin\n"
+    "  a := 12 * (b - 3) / 4;\n"
+    "  while a >= 0 and not b <> 1 loop a := a - 1; end loop;\n"
+    "  if a <= b then print a; else print b; end if;\n"
+    "end;";
+
+// Returns the debug strings of all tokens produced by a scanner, including
+// the EOF token.
+template <typename BufferT>
+std::vector<std::string> ScanAll(std::unique_ptr<BufferT> buffer) {
+  BasicScanner<BufferT> scanner(std::move(buffer));
+  std::vector<std::string> tokens;
+  TokenHandle token;
+  do {
+    token = scanner.NextToken();
+    tokens.push_back(token->DebugString());
+  } while (token->GetTokenType() != TokenType::kEOF);
+  return tokens;
+}
+
+TEST(BasicScannerTest, InstantiationsAgree) {
+  const std::string program = kProgram;
+  const std::vector<std::string> expected = ScanAll<MemoryBuffer>(
+      std::make_unique<MemoryBuffer>(program.data(), program.size()));
+  EXPECT_EQ(expected.size(), 72u);
+  EXPECT_EQ(expected.front(), "kKeyword:kProgram");
+  EXPECT_EQ(expected.back(), "kEOF:EndOfFile");
+
+  std::istringstream stream(program);
+  EXPECT_EQ(ScanAll<StreamBuffer>(std::make_unique<StreamBuffer>(&stream, 5)),
+            expected);
+
+  std::istringstream generic_stream(program);
+  EXPECT_EQ(ScanAll<Buffer>(std::make_unique<StreamBuffer>(&generic_stream)),
+            expected);
+}
+
+// Returns all token values produced by a scanner, including the EOF token,
+// and checks that each value locates its lexeme in a given source.
+template <typename BufferT>
+std::vector<TokenValue> ScanAllValues(std::unique_ptr<BufferT> buffer,
+                                      const std::string& source) {
+  BasicScanner<BufferT> scanner(std::move(buffer));
+  std::vector<TokenValue> values;
+  do {
+    values.push_back(scanner.NextTokenValue());
+    EXPECT_EQ(source.substr(values.back().offset, values.back().length),
+              scanner.Lexeme().ToString());
+  } while (values.back().type != TokenType::kEOF);
+  return values;
+}
+
+TEST(BasicScannerTest, NextTokenValue) {
+  const std::string program = kProgram;
+  const std::vector<TokenValue> expected = ScanAllValues<MemoryBuffer>(
+      std::make_unique<MemoryBuffer>(program.data(), program.size()),
+      program);
+  ASSERT_EQ(expected.size(), 72u);
+  EXPECT_EQ(expected[0], (TokenValue{TokenType::kKeyword,
+      static_cast<int>(KeywordAttribute::kProgram), 0, 7}));
+  EXPECT_EQ(expected[1], (TokenValue{TokenType::kIdentifier, 0, 8, 3}));
+  EXPECT_EQ(expected.back(), (TokenValue{TokenType::kEOF, 0,
+      static_cast<uint32_t>(program.size()), 0}));
+
+  // Offsets stay exact across refills of any size.
+  for (size_t buffer_size = 1; buffer_size <= 16; ++buffer_size) {
+    std::istringstream stream(program);
+    EXPECT_EQ(ScanAllValues<StreamBuffer>(
+                  std::make_unique<StreamBuffer>(&stream, buffer_size),
+                  program),
+              expected) << "buffer size: " << buffer_size;
+  }
+}
+
+TEST(BasicScannerTest, InternsIdentifiers) {
+  const std::string program = "foo := bar + foo; if foo1 then";
+  StringInterner interner;
+  BasicScanner<MemoryBuffer> scanner(
+      std::make_unique<MemoryBuffer>(program.data(), program.size()),
+      &interner);
+  std::vector<int> ids;
+  for (TokenValue value = scanner.NextTokenValue();
+       value.type != TokenType::kEOF; value = scanner.NextTokenValue()) {
+    if (value.type == TokenType::kIdentifier) {
+      ids.push_back(value.attribute);
+    }
+  }
+  EXPECT_EQ(ids, std::vector<int>({0, 1, 0, 2}));
+  EXPECT_EQ(interner.size(), 3u);
+  EXPECT_EQ(interner.Lookup(2).ToString(), "foo1");
+
+  // Identifier tokens refer to the interned names.
+  std::istringstream stream(program);
+  BasicScanner<StreamBuffer> stream_scanner(
+      std::make_unique<StreamBuffer>(&stream, 3), &interner);
+  const TokenHandle token = stream_scanner.NextToken();
+  const IdentifierToken& identifier = static_cast<const IdentifierToken&>(*token);
+  EXPECT_EQ(identifier.GetId(), 0u);
+  EXPECT_EQ(identifier.GetLexeme().data(), interner.Lookup(0).data());
+}
+
+TEST(BasicScannerTest, RecoversFromErrors) {
+  const std::string program = "a := b@c1 + 2;\n  F$ := x?;";
+  const std::vector<TokenValue> expected = {
+      {TokenType::kIdentifier, 0, 0, 1},
+      {TokenType::kPunctuation,
+       static_cast<int>(PunctuationAttribute::kAssignment), 2, 2},
+      {TokenType::kIdentifier, 0, 5, 1},
+      {TokenType::kError, 0, 6, 3},
+      {TokenType::kAddOperator,
+       static_cast<int>(AddOperatorAttribute::kAdd), 10, 1},
+      {TokenType::kNumber, 0, 12, 1},
+      {TokenType::kPunctuation,
+       static_cast<int>(PunctuationAttribute::kSemicolon), 13, 1},
+      {TokenType::kError, 1, 17, 2},
+      {TokenType::kPunctuation,
+       static_cast<int>(PunctuationAttribute::kAssignment), 20, 2},
+      {TokenType::kIdentifier, 0, 23, 1},
+      {TokenType::kError, 2, 24, 1},
+      {TokenType::kPunctuation,
+       static_cast<int>(PunctuationAttribute::kSemicolon), 25, 1},
+      {TokenType::kEOF, 0, 26, 0}};
+
+  LexicalErrorLog memory_log;
+  BasicScanner<MemoryBuffer> scanner(
+      std::make_unique<MemoryBuffer>(program.data(), program.size()));
+  scanner.EnableErrorRecovery(&memory_log);
+  for (const TokenValue& value : expected) {
+    EXPECT_EQ(scanner.NextTokenValue(), value);
+    EXPECT_EQ(scanner.Lexeme().ToString(),
+              program.substr(value.offset, value.length));
+  }
+  ASSERT_EQ(memory_log.size(), 3u);
+  EXPECT_EQ(memory_log.errors()[0].offset, 6u);
+  EXPECT_EQ(memory_log.errors()[0].message, "Invalid character: @");
+  EXPECT_EQ(memory_log.errors()[1].offset, 17u);
+  EXPECT_EQ(memory_log.errors()[1].message, "Invalid character: F");
+  EXPECT_EQ(memory_log.errors()[2].message, "Invalid character: ?");
+
+  for (size_t buffer_size = 1; buffer_size <= 8; ++buffer_size) {
+    std::istringstream stream(program);
+    LexicalErrorLog stream_log;
+    BasicScanner<StreamBuffer> stream_scanner(
+        std::make_unique<StreamBuffer>(&stream, buffer_size));
+    stream_scanner.EnableErrorRecovery(&stream_log);
+    for (const TokenValue& value : expected) {
+      EXPECT_EQ(stream_scanner.NextTokenValue(), value)
+          << "buffer size: " << buffer_size;
+      EXPECT_EQ(stream_scanner.Lexeme().ToString(),
+                program.substr(value.offset, value.length));
+    }
+    EXPECT_EQ(stream_log.size(), 3u);
+  }
+}
+
+TEST(BasicScannerTest, ErrorTokens) {
+  const std::string program = "x := 1a?b";
+  LexicalErrorLog log;
+  BasicScanner<MemoryBuffer> scanner(
+      std::make_unique<MemoryBuffer>(program.data(), program.size()));
+  scanner.EnableErrorRecovery(&log);
+  std::vector<std::string> tokens;
+  TokenHandle token;
+  do {
+    token = scanner.NextToken();
+    tokens.push_back(token->DebugString());
+  } while (token->GetTokenType() != TokenType::kEOF);
+  EXPECT_EQ(tokens, std::vector<std::string>({
+      "kIdentifier:x", "kPunctuation:kAssignment", "kNumber:1",
+      "kIdentifier:a", "kError:?b", "kEOF:EndOfFile"}));
+}
+
+TEST(BasicScannerTest, StopsAtErrorLimit) {
+  const std::string program = "a ! b ! c ! d";
+  LexicalErrorLog log(2);
+  BasicScanner<MemoryBuffer> scanner(
+      std::make_unique<MemoryBuffer>(program.data(), program.size()));
+  scanner.EnableErrorRecovery(&log);
+  std::vector<TokenType> types;
+  for (int i = 0; i < 6; ++i) {
+    types.push_back(scanner.NextTokenValue().type);
+  }
+  EXPECT_EQ(types, std::vector<TokenType>({
+      TokenType::kIdentifier, TokenType::kError, TokenType::kIdentifier,
+      TokenType::kError, TokenType::kEOF, TokenType::kEOF}));
+  EXPECT_TRUE(log.full());
+  EXPECT_EQ(log.size(), 2u);
+}
+
+TEST(BasicScannerDeathTest, IllegalCharacter) {
+  const std::string program = "a := !";
+  BasicScanner<MemoryBuffer> scanner(
+      std::make_unique<MemoryBuffer>(program.data(), program.size()));
+  scanner.NextToken();
+  scanner.NextToken();
+  ASSERT_EXIT(scanner.NextToken(),
+              ::testing::ExitedWithCode(EXIT_FAILURE),
+              "c*Invalid character: !c*");
+}
+
+}  // namespace
+}  // namespace truplc
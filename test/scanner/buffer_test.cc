@@ -17,6 +17,14 @@ class BufferTest : public Buffer, public testing::Test {
   char NextChar() override { return '\0'; }
 
   void UnreadChar(const char c) override {}
+
+  void Mark() override {}
+
+  StringPiece Slice(size_t) const override {
+    return StringPiece();
+  }
+
+  size_t MarkOffset() const override { return 0; }
 };
 
 TEST_F(BufferTest, BufferFatalError) {
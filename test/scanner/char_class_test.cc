@@ -0,0 +1,53 @@
+// Unit tests for the character class table.
+// Copyright 2016 Hieu Le.
+
+#include "scanner/char_class.h"
+
+#include <cctype>
+
+#include "gtest/gtest.h"
+
+namespace truplc {
+namespace {
+
+// The table must be usable in constant expressions.
+static_assert(kCharClassTable.flags['a'] == kLowerClass, "");
+static_assert(kCharClassTable.flags['7'] == kDigitClass, "");
+static_assert(kCharClassTable.flags['\t'] == kWhitespaceClass, "");
+static_assert(kCharClassTable.flags[';'] == kSymbolClass, "");
+static_assert(kCharClassTable.flags['A'] == 0, "");
+static_assert(kCharClassTable.flags[0] == 0, "");
+
+TEST(CharClassTest, AgreesWithStandardClassification) {
+  for (int i = 0; i < 256; ++i) {
+    const char c = static_cast<char>(i);
+    const bool lower = std::islower(i) != 0;
+    const bool digit = std::isdigit(i) != 0;
+    EXPECT_EQ(IsAlpha(c), lower) << "byte " << i;
+    EXPECT_EQ(IsDigit(c), digit) << "byte " << i;
+    EXPECT_EQ(IsAlphanumeric(c), lower || digit) << "byte " << i;
+    EXPECT_EQ(IsWhitespace(c), c == kSpace || c == kTab || c == kNewLine)
+        << "byte " << i;
+  }
+}
+
+TEST(CharClassTest, IsAlphabetChar) {
+  int symbols = 0;
+  for (int i = 0; i < 256; ++i) {
+    const char c = static_cast<char>(i);
+    bool non_alphanum = false;
+    for (const char symbol : kNonAlphanum) {
+      non_alphanum = non_alphanum || symbol == c;
+    }
+    symbols += non_alphanum;
+    EXPECT_EQ(IsAlphabetChar(c),
+              std::islower(i) || std::isdigit(i) || non_alphanum)
+        << "byte " << i;
+  }
+  EXPECT_EQ(symbols, sizeof(kNonAlphanum));
+  EXPECT_FALSE(IsAlphabetChar(kEOFMarker));
+  EXPECT_FALSE(IsAlphabetChar('.'));
+}
+
+}  // namespace
+}  // namespace truplc
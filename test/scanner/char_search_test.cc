@@ -0,0 +1,132 @@
+// Unit tests for block-oriented character searches.
+// Copyright 2016 Hieu Le.
+
+#include "scanner/char_search.h"
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "scanner/char_class.h"
+
+#include "gtest/gtest.h"
+
+namespace truplc {
+namespace {
+
+using internal::SimdLevel;
+
+// Returns every instruction set the host CPU supports.
+std::vector<SimdLevel> SupportedLevels() {
+  std::vector<SimdLevel> levels;
+  for (int level = 0;
+       level <= static_cast<int>(internal::DetectSimdLevel()); ++level) {
+    levels.push_back(static_cast<SimdLevel>(level));
+  }
+  return levels;
+}
+
+// Generates a random string drawn from a given alphabet.
+std::string RandomString(std::mt19937* engine, const std::string& alphabet,
+                         const size_t length) {
+  std::uniform_int_distribution<size_t> pick(0, alphabet.size() - 1);
+  std::string result;
+  for (size_t i = 0; i < length; ++i) {
+    result.push_back(alphabet[pick(*engine)]);
+  }
+  return result;
+}
+
+TEST(CharSearchTest, FindNonWhitespaceBasic) {
+  const std::string input = " \t\n  \n\t\t a b";
+  const char* begin = input.data();
+  const char* end = begin + input.size();
+  EXPECT_EQ(FindNonWhitespace(begin, end), begin + 9);
+  EXPECT_EQ(FindNonWhitespace(begin, begin + 9), begin + 9);
+  EXPECT_EQ(FindNonWhitespace(end, end), end);
+}
+
+TEST(CharSearchTest, FindNewLineBasic) {
+  const std::string input = "#comment with $%^ symbols\nnext";
+  const char* begin = input.data();
+  const char* end = begin + input.size();
+  EXPECT_EQ(FindNewLine(begin, end), begin + 25);
+  EXPECT_EQ(FindNewLine(begin, begin + 25), begin + 25);
+  EXPECT_EQ(FindNewLine(end, end), end);
+}
+
+TEST(CharSearchTest, CountNewLinesBasic) {
+  const std::string input = "a\nb\n\n" + std::string(100, '\n') + "c";
+  EXPECT_EQ(CountNewLines(input.data(), input.data() + input.size()), 103u);
+  EXPECT_EQ(CountNewLines(input.data(), input.data() + 2), 1u);
+  EXPECT_EQ(CountNewLines(input.data(), input.data()), 0u);
+}
+
+TEST(CharSearchTest, FindInvalidCharBasic) {
+  const std::string input = "program foo; a := (b + 1) * 2 <> c;\t\n#F";
+  const char* begin = input.data();
+  const char* end = begin + input.size();
+  EXPECT_EQ(FindInvalidChar(begin, end), end - 1);
+  EXPECT_EQ(FindInvalidChar(begin, end - 1), end - 1);
+  EXPECT_EQ(FindInvalidChar(end, end), end);
+}
+
+TEST(CharSearchTest, FindInvalidCharEveryByte) {
+  for (const SimdLevel level : SupportedLevels()) {
+    for (int c = 0; c < 256; ++c) {
+      // Embed the byte in a valid block long enough for every vector width.
+      std::string input(40, 'a');
+      input[37] = static_cast<char>(c);
+      const char* begin = input.data();
+      const char* end = begin + input.size();
+      const char* expected = IsAlphabetChar(static_cast<char>(c))
+          ? end : begin + 37;
+      EXPECT_EQ(internal::FindInvalidChar(begin, end, level), expected)
+          << "byte " << c;
+      input[3] = static_cast<char>(c);
+      EXPECT_EQ(internal::FindInvalidChar(begin, end, level),
+                expected == end ? end : begin + 3) << "byte " << c;
+    }
+  }
+}
+
+TEST(CharSearchTest, AllLevelsAgreeWithScalar) {
+  std::mt19937 engine(2016);
+  for (const SimdLevel level : SupportedLevels()) {
+    for (size_t length = 0; length < 100; ++length) {
+      for (int trial = 0; trial < 20; ++trial) {
+        const std::string input = RandomString(
+            &engine, std::string(8, ' ') + "\t\n#a1;.A$", length);
+        const char* end = input.data() + input.size();
+        for (const char* begin = input.data(); begin != end; ++begin) {
+          EXPECT_EQ(internal::FindNonWhitespace(begin, end, level),
+                    internal::FindNonWhitespace(begin, end,
+                                                SimdLevel::kScalar));
+          EXPECT_EQ(internal::FindNewLine(begin, end, level),
+                    internal::FindNewLine(begin, end, SimdLevel::kScalar));
+          EXPECT_EQ(internal::FindInvalidChar(begin, end, level),
+                    internal::FindInvalidChar(begin, end,
+                                              SimdLevel::kScalar));
+          EXPECT_EQ(internal::CountNewLines(begin, end, level),
+                    internal::CountNewLines(begin, end, SimdLevel::kScalar));
+        }
+      }
+    }
+  }
+}
+
+TEST(CharSearchTest, LongRuns) {
+  for (const SimdLevel level : SupportedLevels()) {
+    const std::string spaces = std::string(1000, ' ') + "\t\n" + "x";
+    EXPECT_EQ(internal::FindNonWhitespace(
+        spaces.data(), spaces.data() + spaces.size(), level),
+              spaces.data() + 1002);
+    const std::string comment = "#" + std::string(1000, '$') + "\n";
+    EXPECT_EQ(internal::FindNewLine(
+        comment.data(), comment.data() + comment.size(), level),
+              comment.data() + 1001);
+  }
+}
+
+}  // namespace
+}  // namespace truplc
@@ -0,0 +1,204 @@
+// Unit tests for IncrementalLexer class.
+// Copyright 2016 Hieu Le.
+
+#include "scanner/incremental_lexer.h"
+
+#include <random>
+#include <string>
+
+#include "scanner/scanner.h"
+
+#include "gtest/gtest.h"
+
+namespace truplc {
+namespace {
+
+const std::string kProgram =
+    "program foo;\n"
+    "# Computes a sum.\n"
+    "  a := b + 12;\n"
+    "  if a <> 3 then c := a * 2;\n";
+
+// Checks that the tokens of a lexer match those of a full scan of its
+// document. Identifiers are compared by name, as the two interners differ.
+void ExpectFullScanTokens(const IncrementalLexer& lexer) {
+  const std::string& text = lexer.text();
+  Scanner scanner(text.data(), text.size());
+  scanner.EnableErrorRecovery(0);
+  const TokenStream expected = scanner.TokenizeAll();
+  ASSERT_EQ(lexer.size(), text.size());
+  ASSERT_EQ(lexer.token_count() + 1, expected.size()) << text;
+  for (size_t i = 0; i < lexer.token_count(); ++i) {
+    const TokenValue actual = lexer.token(i);
+    EXPECT_EQ(actual.type, expected.type(i)) << text;
+    EXPECT_EQ(actual.offset, expected.offset(i)) << text;
+    EXPECT_EQ(actual.length, expected.length(i)) << text;
+    EXPECT_EQ(lexer.Lexeme(i), StringPiece(text.data() + actual.offset,
+                                           actual.length)) << text;
+    if (actual.type == TokenType::kIdentifier) {
+      EXPECT_EQ(lexer.interner().Lookup(
+                    static_cast<StringInterner::Id>(actual.attribute)),
+                scanner.interner()->Lookup(
+                    static_cast<StringInterner::Id>(expected.attribute(i))));
+    } else if (actual.type != TokenType::kError) {
+      EXPECT_EQ(actual.attribute, expected.attribute(i));
+    }
+  }
+}
+
+TEST(IncrementalLexerTest, ScansDocument) {
+  const IncrementalLexer lexer(kProgram);
+  EXPECT_EQ(lexer.text(), kProgram);
+  ASSERT_EQ(lexer.token_count(), 20u);
+  EXPECT_EQ(lexer.Lexeme(1).ToString(), "foo");
+  ExpectFullScanTokens(lexer);
+}
+
+TEST(IncrementalLexerTest, EditInsideToken) {
+  IncrementalLexer lexer(kProgram);
+  const std::string& text = kProgram;
+  TokenChange change;
+
+  // "12" becomes "123": only the number changes.
+  ASSERT_TRUE(lexer.Edit(text.find("12") + 2, 0, std::string("3"), &change));
+  EXPECT_EQ(change.first, 7u);
+  EXPECT_EQ(change.removed, 1u);
+  EXPECT_EQ(change.inserted, 1u);
+  EXPECT_EQ(lexer.Lexeme(7).ToString(), "123");
+  ExpectFullScanTokens(lexer);
+
+  // "b" becomes "b1": the identifier changes.
+  ASSERT_TRUE(lexer.Edit(text.find("b "), 1, std::string("b1"), &change));
+  EXPECT_EQ(change.first, 5u);
+  EXPECT_EQ(change.removed, 1u);
+  EXPECT_EQ(change.inserted, 1u);
+  EXPECT_EQ(lexer.Lexeme(5).ToString(), "b1");
+  ExpectFullScanTokens(lexer);
+}
+
+TEST(IncrementalLexerTest, EditMergesAndSplitsTokens) {
+  IncrementalLexer lexer(kProgram);
+  const std::string& text = kProgram;
+  TokenChange change;
+
+  // Removing the spaces around "+" only moves the tokens: "+" was edited
+  // and is replaced, while "12" follows the edit and is kept.
+  ASSERT_TRUE(lexer.Edit(text.find(" + "), 3, std::string("+"), &change));
+  EXPECT_EQ(change.first, 6u);
+  EXPECT_EQ(change.removed, 1u);
+  EXPECT_EQ(change.inserted, 1u);
+  ExpectFullScanTokens(lexer);
+
+  // "<>" split by a space becomes "<" and ">".
+  ASSERT_TRUE(lexer.Edit(lexer.text().find("<>") + 1, 0, std::string(" "),
+                         &change));
+  EXPECT_EQ(change.removed, 1u);
+  EXPECT_EQ(change.inserted, 2u);
+  ExpectFullScanTokens(lexer);
+}
+
+TEST(IncrementalLexerTest, EditLines) {
+  IncrementalLexer lexer(kProgram);
+  TokenChange change;
+
+  // Commenting out a line removes its tokens.
+  const size_t line = lexer.text().find("  a :=");
+  ASSERT_TRUE(lexer.Edit(line, 0, std::string("#"), &change));
+  EXPECT_EQ(change.first, 3u);
+  EXPECT_EQ(change.removed, 6u);
+  EXPECT_EQ(change.inserted, 0u);
+  ExpectFullScanTokens(lexer);
+
+  // Joining the comment to the next line hides that line too.
+  ASSERT_TRUE(lexer.Edit(lexer.text().find("12;\n") + 3, 1, StringPiece(),
+                         &change));
+  EXPECT_EQ(change.first, 3u);
+  EXPECT_EQ(change.removed, 11u);
+  EXPECT_EQ(change.inserted, 0u);
+  EXPECT_EQ(lexer.token_count(), 3u);
+  ExpectFullScanTokens(lexer);
+
+  // Inserting lines.
+  ASSERT_TRUE(lexer.Edit(0, 0, std::string("x := 1;\ny := 2;\n"), &change));
+  EXPECT_EQ(change.first, 0u);
+  EXPECT_EQ(change.removed, 0u);
+  EXPECT_EQ(change.inserted, 8u);
+  ExpectFullScanTokens(lexer);
+}
+
+TEST(IncrementalLexerTest, EditRecoversFromErrors) {
+  IncrementalLexer lexer(std::string("a := b;\n"));
+  TokenChange change;
+  ASSERT_TRUE(lexer.Edit(5, 0, std::string("@"), &change));
+  EXPECT_EQ(change.first, 2u);
+  EXPECT_EQ(change.removed, 1u);
+  EXPECT_EQ(change.inserted, 1u);
+  EXPECT_EQ(lexer.token(2).type, TokenType::kError);
+  EXPECT_EQ(lexer.Lexeme(2).ToString(), "@b");
+  ExpectFullScanTokens(lexer);
+
+  ASSERT_TRUE(lexer.Edit(5, 1, StringPiece(), nullptr));
+  EXPECT_EQ(lexer.token(2).type, TokenType::kIdentifier);
+  ExpectFullScanTokens(lexer);
+}
+
+TEST(IncrementalLexerTest, EditOutOfRange) {
+  IncrementalLexer lexer(std::string("a := b;"));
+  EXPECT_FALSE(lexer.Edit(8, 0, std::string("c"), nullptr));
+  EXPECT_FALSE(lexer.Edit(5, 3, StringPiece(), nullptr));
+  EXPECT_EQ(lexer.text(), "a := b;");
+  EXPECT_TRUE(lexer.Edit(7, 0, std::string(" c"), nullptr));
+  EXPECT_EQ(lexer.text(), "a := b; c");
+  ExpectFullScanTokens(lexer);
+}
+
+TEST(IncrementalLexerTest, ChunkedDocument) {
+  // Chunks of about one line: the document is split at every new line.
+  IncrementalLexer lexer(kProgram, 8);
+  EXPECT_EQ(lexer.text(), kProgram);
+  EXPECT_EQ(lexer.Lexeme(18).ToString(), "2");
+  ExpectFullScanTokens(lexer);
+
+  // Tokens of earlier chunks are counted in the change.
+  TokenChange change;
+  ASSERT_TRUE(lexer.Edit(kProgram.find("12") + 2, 0, std::string("3"),
+                         &change));
+  EXPECT_EQ(change.first, 7u);
+  EXPECT_EQ(change.removed, 1u);
+  EXPECT_EQ(change.inserted, 1u);
+  ExpectFullScanTokens(lexer);
+
+  // Removing every new line merges the chunks; restoring them splits them.
+  for (size_t offset = lexer.text().find('\n'); offset != std::string::npos;
+       offset = lexer.text().find('\n')) {
+    ASSERT_TRUE(lexer.Edit(offset, 1, std::string(" "), nullptr));
+    ExpectFullScanTokens(lexer);
+  }
+  ASSERT_TRUE(lexer.Edit(0, lexer.size(), kProgram, &change));
+  EXPECT_EQ(lexer.text(), kProgram);
+  ExpectFullScanTokens(lexer);
+}
+
+TEST(IncrementalLexerTest, RandomEdits) {
+  static const std::string kSnippets[] = {
+      "a", "12", " ", "\n", ":=", "<", ">", "#", ";", "begin", "end", "@",
+      "x := 1;\ny := 2;\n"};
+  // Small chunks are split and merged by most edits.
+  for (const size_t chunk_size :
+       {size_t{1}, size_t{8}, size_t{32}, IncrementalLexer::kDefaultChunkSize}) {
+    std::mt19937 random(2016);
+    IncrementalLexer lexer(kProgram, chunk_size);
+    for (int i = 0; i < 500; ++i) {
+      const size_t size = lexer.size();
+      const size_t offset = random() % (size + 1);
+      const size_t removed =
+          random() % (std::min<size_t>(size - offset, 8) + 1);
+      const std::string& inserted = kSnippets[random() % 13];
+      ASSERT_TRUE(lexer.Edit(offset, removed, inserted, nullptr));
+      ExpectFullScanTokens(lexer);
+    }
+  }
+}
+
+}  // namespace
+}  // namespace truplc
@@ -0,0 +1,52 @@
+// Unit tests for the keyword perfect hash table.
+// Copyright 2016 Hieu Le.
+
+#include "scanner/keyword_table.h"
+
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace truplc {
+namespace internal {
+namespace {
+
+// The table must be usable in constant expressions.
+static_assert(kKeywordTable.min_length == 2, "");
+static_assert(kKeywordTable.max_length == 9, "");
+
+TEST(KeywordTableTest, FindsEveryWord) {
+  for (const LexemeSpec& spec : kWordSpecs) {
+    const std::string word = spec.lexeme;
+    const LexemeAction action = FindWord(word);
+    EXPECT_EQ(spec.action.type, action.type) << word;
+    EXPECT_EQ(spec.action.attribute, action.attribute) << word;
+  }
+}
+
+TEST(KeywordTableTest, EveryWordHasItsOwnSlot) {
+  int used = 0;
+  for (const KeywordSlot& slot : kKeywordTable.slots) {
+    used += slot.length != 0;
+  }
+  EXPECT_EQ(static_cast<int>(sizeof(kWordSpecs) / sizeof(kWordSpecs[0])),
+            used);
+}
+
+TEST(KeywordTableTest, OtherWordsAreIdentifiers) {
+  for (const std::string word : {"", "a", "i", "programs", "progra", "begins",
+                                 "iff", "nod", "thenx", "procedures", "pr1nt",
+                                 "xyzzy", "end0", "orr", "an"}) {
+    EXPECT_EQ(TokenType::kIdentifier, FindWord(word).type) << word;
+  }
+}
+
+TEST(KeywordTableTest, ComparesTheWholeWord) {
+  // Same length, first, second and last characters as "procedure".
+  EXPECT_EQ(TokenType::kIdentifier, FindWord(std::string("prxxxxxxe")).type);
+  EXPECT_EQ(TokenType::kKeyword, FindWord(std::string("procedure")).type);
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace truplc
@@ -0,0 +1,74 @@
+// Unit tests for the lexer transition table.
+// Copyright 2016 Hieu Le.
+
+#include "scanner/lexer_table.h"
+
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace truplc {
+namespace internal {
+namespace {
+
+// The table must be usable in constant expressions.
+static_assert(kLexerTable.next[kStartState][kLexerTable.byte_class['z']]
+              == kIdentifierState, "");
+static_assert(kLexerTable.next[kStartState][kLexerTable.byte_class['7']]
+              == kNumberState, "");
+static_assert(kLexerTable.next[kStartState][kLexerTable.byte_class[' ']]
+              == kNoState, "");
+
+// Runs the automaton over a whole lexeme and returns the action of the final
+// state, or kUnspecified if the lexeme is rejected before its end.
+LexemeAction Recognize(const std::string& lexeme) {
+  uint8_t state = kStartState;
+  for (const char c : lexeme) {
+    state = kLexerTable.next[state]
+                            [kLexerTable.byte_class[static_cast<uint8_t>(c)]];
+    if (state == kNoState) {
+      return {TokenType::kUnspecified, 0};
+    }
+  }
+  return kLexerTable.action[state];
+}
+
+TEST(LexerTableTest, AcceptsEverySpecifiedLexeme) {
+  for (const LexemeSpec& spec : kOperatorSpecs) {
+    const LexemeAction action = Recognize(spec.lexeme);
+    EXPECT_EQ(spec.action.type, action.type) << spec.lexeme;
+    EXPECT_EQ(spec.action.attribute, action.attribute) << spec.lexeme;
+  }
+}
+
+TEST(LexerTableTest, WordsAreIdentifiers) {
+  // Keywords are told apart from identifiers by the keyword table.
+  for (const std::string lexeme : {"p", "program", "programs", "and", "if0",
+                                   "x", "o1"}) {
+    EXPECT_EQ(TokenType::kIdentifier, Recognize(lexeme).type) << lexeme;
+  }
+}
+
+TEST(LexerTableTest, Numbers) {
+  EXPECT_EQ(TokenType::kNumber, Recognize("0").type);
+  EXPECT_EQ(TokenType::kNumber, Recognize("1234567890").type);
+  EXPECT_EQ(TokenType::kUnspecified, Recognize("12a").type);
+}
+
+TEST(LexerTableTest, RejectsMalformedLexemes) {
+  for (const std::string lexeme : {"", " ", "$", "=<", "::", ";;", "+a",
+                                   "a;"}) {
+    EXPECT_EQ(TokenType::kUnspecified, Recognize(lexeme).type) << lexeme;
+  }
+}
+
+TEST(LexerTableTest, SpaceNeverExtendsALexeme) {
+  const uint8_t space = kLexerTable.byte_class[static_cast<uint8_t>(kSpace)];
+  for (int state = 0; state < kLexerTable.num_states; ++state) {
+    EXPECT_EQ(kNoState, kLexerTable.next[state][space]) << state;
+  }
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace truplc
@@ -1,7 +1,12 @@
 // End to end tests for TruPL lexical analyzer.
 // Copyright 2016 Hieu Le.
 
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <fstream>
 #include <sstream>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -28,7 +33,7 @@ class LexicalAnalyzerTest : public testing::Test {
                    const std::vector<Token*>& tokens) {
     Scanner scanner(CreateBuffer(input));
     for (const auto& token : tokens) {
-      std::unique_ptr<Token> actual(scanner.NextToken());
+      const TokenHandle actual = scanner.NextToken();
       std::unique_ptr<Token> expected(token);
       EXPECT_EQ(actual->DebugString(), expected->DebugString());
     }
@@ -90,5 +95,40 @@ TEST_F(LexicalAnalyzerTest, CommentAndWhitespace) {
             new PRINT, new NUMBER("0"), new SEMICOLON });
 }
 
+// Tests if the tokens read by a scanner from a named source file matches a list
+// of expected tokens.
+void MatchFileTokens(const std::string& filename,
+                     const std::vector<Token*>& tokens) {
+  Scanner scanner(filename);
+  for (const auto& token : tokens) {
+    const TokenHandle actual = scanner.NextToken();
+    std::unique_ptr<Token> expected(token);
+    EXPECT_EQ(actual->DebugString(), expected->DebugString());
+  }
+}
+
+TEST(LexicalAnalyzerFileTest, RegularFile) {
+  char filename[] = "/tmp/lexical_analyzer_test.XXXXXX";
+  close(mkstemp(filename));
+  std::ofstream(filename) << "#comment\nprogram foo;\n  i := 10; #done";
+  MatchFileTokens(filename, { new PROGRAM, new IDENTIFIER("foo"),
+          new SEMICOLON, new IDENTIFIER("i"), new ASSIGNMENT, new NUMBER("10"),
+          new SEMICOLON, new ENDOFFILE });
+  unlink(filename);
+}
+
+TEST(LexicalAnalyzerFileTest, Pipe) {
+  const std::string filename =
+      "/tmp/lexical_analyzer_test.fifo." + std::to_string(getpid());
+  ASSERT_EQ(mkfifo(filename.c_str(), 0600), 0);
+  std::thread writer([&filename] {
+    std::ofstream(filename) << "while a <> 1 loop";
+  });
+  MatchFileTokens(filename, { new WHILE, new IDENTIFIER("a"), new NOTEQUAL,
+          new NUMBER("1"), new LOOP, new ENDOFFILE });
+  writer.join();
+  unlink(filename.c_str());
+}
+
 }  // namespace
 }  // namespace truplc
@@ -0,0 +1,40 @@
+// Unit tests for LexicalErrorLog class.
+// Copyright 2016 Hieu Le.
+
+#include "scanner/lexical_error_log.h"
+
+#include "gtest/gtest.h"
+
+namespace truplc {
+namespace {
+
+TEST(LexicalErrorLogTest, Record) {
+  LexicalErrorLog log;
+  EXPECT_TRUE(log.empty());
+  EXPECT_EQ(log.max_errors(), LexicalErrorLog::kDefaultMaxErrors);
+
+  log.Record(3, "Invalid character: @");
+  log.Record(9, "Invalid character: F");
+  ASSERT_EQ(log.size(), 2u);
+  EXPECT_EQ(log.errors()[0].offset, 3u);
+  EXPECT_EQ(log.errors()[1].offset, 9u);
+  EXPECT_EQ(log.errors()[1].message, "Invalid character: F");
+}
+
+TEST(LexicalErrorLogTest, Full) {
+  LexicalErrorLog log(2);
+  log.Record(0, "a");
+  EXPECT_FALSE(log.full());
+  log.Record(1, "b");
+  EXPECT_TRUE(log.full());
+
+  // A limit of 0 means no limit.
+  LexicalErrorLog unlimited(0);
+  for (size_t i = 0; i < 2 * LexicalErrorLog::kDefaultMaxErrors; ++i) {
+    unlimited.Record(i, "c");
+  }
+  EXPECT_FALSE(unlimited.full());
+}
+
+}  // namespace
+}  // namespace truplc
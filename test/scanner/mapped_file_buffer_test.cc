@@ -0,0 +1,153 @@
+// Unit tests for MappedFileBuffer class.
+// Copyright 2016 Hieu Le.
+
+#include "scanner/mapped_file_buffer.h"
+
+#include <unistd.h>
+
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace truplc {
+namespace {
+
+// Writes given content to a fresh temporary file and removes it on scope exit.
+class TemporaryFile {
+ public:
+  explicit TemporaryFile(const std::string& content) {
+    char name[] = "/tmp/mapped_file_buffer_test.XXXXXX";
+    const int fd = mkstemp(name);
+    close(fd);
+    name_ = name;
+    std::ofstream(name_, std::ios::binary) << content;
+  }
+
+  ~TemporaryFile() { unlink(name_.c_str()); }
+
+  const std::string& name() const { return name_; }
+
+ private:
+  std::string name_;
+};
+
+// Test if MappedFileBuffer generates on specified input an expected sequence
+// of characters.
+void TestNextChar(const std::string& input,
+                  const std::vector<char>& expected) {
+  TemporaryFile file(input);
+  MappedFileBuffer buffer(file.name());
+  for (const char c : expected) {
+    EXPECT_EQ(buffer.NextChar(), c);
+  }
+}
+
+TEST(MappedFileBufferTest, NextCharBasic) {
+  TestNextChar("bool", {'b', 'o', 'o', 'l', kEOFMarker});
+  TestNextChar("int a;", {'i', 'n', 't', kSpace, 'a', ';', kEOFMarker});
+  TestNextChar("a = 3;", {'a', kSpace, '=', kSpace, '3', ';', kEOFMarker});
+  TestNextChar("if(a )", {'i', 'f', '(', 'a', kSpace, ')', kEOFMarker});
+  TestNextChar(";:(),=<>+-",
+               {';', ':', '(', ')', ',', '=', '<', '>', '+', '-', kEOFMarker});
+  TestNextChar("", {kEOFMarker});
+  TestNextChar("a", {'a', kEOFMarker, kEOFMarker, kEOFMarker});
+}
+
+TEST(MappedFileBufferTest, NextCharWithWhitespace) {
+  TestNextChar("a b", {'a', kSpace, 'b', kEOFMarker});
+  TestNextChar("a\n\nb", {'a', kSpace, 'b', kEOFMarker});
+  TestNextChar("\n\n\t a", {'a', kEOFMarker});
+  TestNextChar("a \n\t ", {'a', kSpace, kEOFMarker});
+  TestNextChar("  \n\n\t\t  ", {kEOFMarker});
+}
+
+TEST(MappedFileBufferTest, NextCharWithComments) {
+  TestNextChar("f#abc def ghi\nb", {'f', kSpace, 'b', kEOFMarker});
+  TestNextChar("a#foo quoz bar \n#bar\nb", {'a', kSpace, 'b', kEOFMarker});
+  TestNextChar("#this #is #comment\na#abcxyz", {'a', kSpace, kEOFMarker});
+  TestNextChar("#this is a comment\na", {'a', kEOFMarker});
+  TestNextChar("a#this is a comment", {'a', kSpace, kEOFMarker});
+  TestNextChar("#this is a comment", {kEOFMarker});
+  TestNextChar("abc #!@#$%^&*\n", {'a', 'b', 'c', kSpace, kEOFMarker});
+  TestNextChar("#$$$", {kEOFMarker});
+}
+
+TEST(MappedFileBufferTest, NextCharWithLongInput) {
+  std::string input;
+  std::vector<char> expected;
+  for (int i = 0; i < 20000; ++i) {
+    input.append("\n\t#abc$$$$@@@\n a #^&*0099** #0\t\t\t123\n");
+    expected.push_back('a');
+    expected.push_back(kSpace);
+  }
+  expected.push_back(kEOFMarker);
+  TestNextChar(input, expected);
+}
+
+TEST(MappedFileBufferTest, UnreadCharBasic) {
+  TemporaryFile file("a");
+  MappedFileBuffer buffer(file.name());
+  const char result = buffer.NextChar();
+  EXPECT_EQ(result, 'a');
+  buffer.UnreadChar(result);
+  EXPECT_EQ(buffer.NextChar(), result);
+  EXPECT_EQ(buffer.NextChar(), kEOFMarker);
+  buffer.UnreadChar(kEOFMarker);
+  EXPECT_EQ(buffer.NextChar(), kEOFMarker);
+}
+
+TEST(MappedFileBufferTest, UnreadCompressedSpace) {
+  TemporaryFile file("a #comment");
+  MappedFileBuffer buffer(file.name());
+  EXPECT_EQ(buffer.NextChar(), 'a');
+  EXPECT_EQ(buffer.NextChar(), kSpace);
+  buffer.UnreadChar(kSpace);
+  EXPECT_EQ(buffer.NextChar(), kSpace);
+  EXPECT_EQ(buffer.NextChar(), kEOFMarker);
+}
+
+TEST(MappedFileBufferTest, SlicePointsIntoMapping) {
+  TemporaryFile file("  abc;#comment\n def42 ");
+  MappedFileBuffer buffer(file.name());
+  EXPECT_TRUE(buffer.HasStableSlices());
+
+  buffer.Mark();
+  EXPECT_EQ(buffer.NextChar(), 'a');
+  EXPECT_EQ(buffer.NextChar(), 'b');
+  EXPECT_EQ(buffer.NextChar(), 'c');
+  const StringPiece abc = buffer.Slice(3);
+  EXPECT_EQ(buffer.NextChar(), ';');
+  EXPECT_EQ(buffer.NextChar(), kSpace);
+
+  buffer.Mark();
+  for (const char c : std::string("def42")) {
+    EXPECT_EQ(buffer.NextChar(), c);
+  }
+  EXPECT_EQ(buffer.NextChar(), kSpace);
+  const StringPiece def42 = buffer.Slice(5);
+  EXPECT_EQ(buffer.NextChar(), kEOFMarker);
+
+  // Earlier slices stay valid as the buffer moves on.
+  EXPECT_EQ(abc.ToString(), "abc");
+  EXPECT_EQ(def42.ToString(), "def42");
+}
+
+TEST(MappedFileBufferDeathTest, ConstructWithIllegalFilename) {
+  ASSERT_EXIT({ MappedFileBuffer buffer("Foo"); },
+              ::testing::ExitedWithCode(EXIT_FAILURE),
+              "c*Error opening source file: Fooc*");
+}
+
+TEST(MappedFileBufferDeathTest, NextCharIllegalInput) {
+  TemporaryFile file("FOO");
+  MappedFileBuffer buffer(file.name());
+  ASSERT_EXIT(buffer.NextChar(),
+              ::testing::ExitedWithCode(EXIT_FAILURE),
+              "c*Invalid character: Fc*");
+}
+
+}  // namespace
+}  // namespace truplc
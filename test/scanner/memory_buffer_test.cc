@@ -0,0 +1,177 @@
+// Unit tests for MemoryBuffer class.
+// Copyright 2016 Hieu Le.
+
+#include "scanner/memory_buffer.h"
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace truplc {
+namespace {
+
+// Test if MemoryBuffer generates on specified input an expected sequence of
+// characters.
+void TestNextChar(const std::string& input,
+                  const std::vector<char>& expected) {
+  MemoryBuffer buffer(input.data(), input.size());
+  for (const char c : expected) {
+    EXPECT_EQ(buffer.NextChar(), c);
+  }
+}
+
+TEST(MemoryBufferTest, NextCharBasic) {
+  TestNextChar("bool", {'b', 'o', 'o', 'l', kEOFMarker});
+  TestNextChar("int a;", {'i', 'n', 't', kSpace, 'a', ';', kEOFMarker});
+  TestNextChar("a = 3;", {'a', kSpace, '=', kSpace, '3', ';', kEOFMarker});
+  TestNextChar("if(a )", {'i', 'f', '(', 'a', kSpace, ')', kEOFMarker});
+  TestNextChar("", {kEOFMarker});
+  TestNextChar("a", {'a', kEOFMarker, kEOFMarker, kEOFMarker});
+}
+
+TEST(MemoryBufferTest, NextCharWithWhitespaceAndComments) {
+  TestNextChar("\n\n\t a", {'a', kEOFMarker});
+  TestNextChar("a \n\t ", {'a', kSpace, kEOFMarker});
+  TestNextChar("  \n\n\t\t  ", {kEOFMarker});
+  TestNextChar("a#foo quoz bar \n#bar\nb", {'a', kSpace, 'b', kEOFMarker});
+  TestNextChar("abc #!@#$%^&*\n", {'a', 'b', 'c', kSpace, kEOFMarker});
+  TestNextChar(" a #foo bar \n \t   b #foo\n\t c#foo bar",
+               {'a', kSpace, 'b', kSpace, 'c', kSpace, kEOFMarker});
+}
+
+TEST(MemoryBufferTest, DoesNotReadPastSize) {
+  const std::string input = "ab cd";
+  TestNextChar(input.substr(0, 4), {'a', 'b', kSpace, 'c', kEOFMarker});
+  MemoryBuffer buffer(input.data(), 2);
+  EXPECT_EQ(buffer.NextChar(), 'a');
+  EXPECT_EQ(buffer.NextChar(), 'b');
+  EXPECT_EQ(buffer.NextChar(), kEOFMarker);
+}
+
+TEST(MemoryBufferTest, UnreadChar) {
+  const std::string input = "a #comment\n b";
+  MemoryBuffer buffer(input.data(), input.size());
+  EXPECT_EQ(buffer.NextChar(), 'a');
+  buffer.UnreadChar('a');
+  EXPECT_EQ(buffer.NextChar(), 'a');
+  EXPECT_EQ(buffer.NextChar(), kSpace);
+  buffer.UnreadChar(kSpace);
+  EXPECT_EQ(buffer.NextChar(), kSpace);
+  EXPECT_EQ(buffer.NextChar(), 'b');
+  EXPECT_EQ(buffer.NextChar(), kEOFMarker);
+  buffer.UnreadChar(kEOFMarker);
+  EXPECT_EQ(buffer.NextChar(), kEOFMarker);
+}
+
+TEST(MemoryBufferTest, SliceDoesNotCopy) {
+  const std::string input = "foo42;";
+  MemoryBuffer buffer(input.data(), input.size());
+  EXPECT_TRUE(buffer.HasStableSlices());
+  buffer.Mark();
+  for (int i = 0; i < 5; ++i) {
+    buffer.NextChar();
+  }
+  const StringPiece lexeme = buffer.Slice(5);
+  EXPECT_EQ(lexeme.data(), input.data());
+  EXPECT_EQ(lexeme.ToString(), "foo42");
+}
+
+TEST(MemoryBufferTest, MarkOffset) {
+  const std::string input = "\t#comment\n a1 := 2";
+  MemoryBuffer buffer(input.data(), input.size());
+  buffer.Mark();
+  EXPECT_EQ(buffer.MarkOffset(), 11u);
+  EXPECT_EQ(buffer.NextChar(), 'a');
+  EXPECT_EQ(buffer.NextChar(), '1');
+  EXPECT_EQ(buffer.NextChar(), kSpace);
+  buffer.Mark();
+  EXPECT_EQ(buffer.MarkOffset(), 14u);
+}
+
+TEST(MemoryBufferDeathTest, NextCharIllegalInput) {
+  const std::string input = "a FOO";
+  MemoryBuffer buffer(input.data(), input.size());
+  EXPECT_EQ(buffer.NextChar(), 'a');
+  EXPECT_EQ(buffer.NextChar(), kSpace);
+  ASSERT_EXIT(buffer.NextChar(),
+              ::testing::ExitedWithCode(EXIT_FAILURE),
+              "c*Invalid character: Fc*");
+}
+
+TEST(MemoryBufferDeathTest, IllegalInputLocation) {
+  const std::string input = "a\n  b F";
+  MemoryBuffer buffer(input.data(), input.size());
+  EXPECT_EQ(buffer.NextChar(), 'a');
+  EXPECT_EQ(buffer.NextChar(), kSpace);
+  EXPECT_EQ(buffer.NextChar(), 'b');
+  EXPECT_EQ(buffer.NextChar(), kSpace);
+  ASSERT_EXIT(buffer.NextChar(),
+              ::testing::ExitedWithCode(EXIT_FAILURE),
+              "Invalid character: F at line 2, column 5");
+}
+
+TEST(MemoryBufferTest, RecoversInvalidChars) {
+  const std::string input = "aF$ #!\n%";
+  MemoryBuffer buffer(input.data(), input.size());
+  buffer.set_recover_invalid_chars(true);
+  buffer.Mark();
+  EXPECT_EQ(buffer.NextChar(), 'a');
+  EXPECT_EQ(buffer.NextChar(), kInvalidMarker);
+  buffer.UnreadChar(kInvalidMarker);
+  EXPECT_EQ(buffer.NextChar(), kInvalidMarker);
+  EXPECT_EQ(buffer.NextChar(), kInvalidMarker);
+  EXPECT_EQ(buffer.Slice(3).ToString(), "aF$");
+  // Invalid characters within comments are skipped as usual.
+  EXPECT_EQ(buffer.NextChar(), kSpace);
+  EXPECT_EQ(buffer.NextChar(), kInvalidMarker);
+  EXPECT_EQ(buffer.NextChar(), kEOFMarker);
+}
+
+TEST(MemoryBufferTest, ConstructFromStringPiece) {
+  const std::string input = "ab c";
+  MemoryBuffer buffer(StringPiece(input.data() + 1, 3));
+  buffer.Mark();
+  EXPECT_EQ(buffer.NextChar(), 'b');
+  EXPECT_EQ(buffer.Slice(1).data(), input.data() + 1);
+  EXPECT_EQ(buffer.NextChar(), kSpace);
+  EXPECT_EQ(buffer.NextChar(), 'c');
+  EXPECT_EQ(buffer.NextChar(), kEOFMarker);
+}
+
+TEST(MemoryBufferTest, ConstructFromSourceRange) {
+  const std::string source = "ab\ncd e\nfg";
+  MemoryBuffer buffer(source, 3, 8);
+  buffer.Mark();
+  EXPECT_EQ(buffer.MarkOffset(), 3u);
+  EXPECT_EQ(buffer.NextChar(), 'c');
+  EXPECT_EQ(buffer.NextChar(), 'd');
+  EXPECT_EQ(buffer.NextChar(), kSpace);
+  buffer.Mark();
+  EXPECT_EQ(buffer.MarkOffset(), 6u);
+  EXPECT_EQ(buffer.NextChar(), 'e');
+  EXPECT_EQ(buffer.NextChar(), kSpace);
+  EXPECT_EQ(buffer.NextChar(), kEOFMarker);
+  EXPECT_EQ(buffer.Text().data(), source.data());
+  EXPECT_EQ(buffer.Text().size(), source.size());
+}
+
+TEST(MemoryBufferDeathTest, SourceRangeInputLocation) {
+  const std::string source = "a\nb\n  c F";
+  MemoryBuffer buffer(source, 4, source.size());
+  EXPECT_EQ(buffer.NextChar(), 'c');
+  EXPECT_EQ(buffer.NextChar(), kSpace);
+  ASSERT_EXIT(buffer.NextChar(),
+              ::testing::ExitedWithCode(EXIT_FAILURE),
+              "Invalid character: F at line 3, column 5");
+}
+
+TEST(MemoryBufferTest, Text) {
+  const std::string input = "a b";
+  MemoryBuffer buffer(input.data(), input.size());
+  EXPECT_EQ(buffer.Text().data(), input.data());
+  EXPECT_EQ(buffer.Text().size(), input.size());
+}
+
+}  // namespace
+}  // namespace truplc
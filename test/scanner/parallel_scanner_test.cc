@@ -0,0 +1,179 @@
+// Unit tests for ParallelScanner class.
+// Copyright 2016 Hieu Le.
+
+#include "scanner/parallel_scanner.h"
+
+#include <unistd.h>
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "scanner/memory_buffer.h"
+#include "scanner/scanner.h"
+#include "tokens/token_value.h"
+
+#include "gtest/gtest.h"
+
+namespace truplc {
+namespace {
+
+const char kProgram[] =
+    "program foo;\n"
+    "  a, b: int; # Variables.\n"
+    "\n"
+    "  procedure bar(x: bool) begin print x; end;\n"
+    "# A comment line.\n"
+    "begin\n"
+    "  a := 12 * (b - 3) / 4;\n"
+    "  while a >= 0 and not b <> 1 loop a := a - 1; end loop;\n"
+    "  if a <= b then print a; else print b; end if;\n"
+    "end;   # Trailing comment.\n\n";
+
+// Returns all token values produced by Scanner for a text, including the EOF
+// token.
+std::vector<TokenValue> ScanSequentially(const std::string& text) {
+  Scanner scanner(std::make_unique<MemoryBuffer>(text.data(), text.size()));
+  std::vector<TokenValue> values;
+  do {
+    values.push_back(scanner.NextTokenValue());
+  } while (values.back().type != TokenType::kEOF);
+  return values;
+}
+
+// Writes given content to a fresh temporary file and returns its name.
+std::string WriteTemporaryFile(const std::string& content) {
+  char name[] = "/tmp/parallel_scanner_test.XXXXXX";
+  const int fd = mkstemp(name);
+  close(fd);
+  std::ofstream(name, std::ios::binary) << content;
+  return name;
+}
+
+TEST(ParallelScannerTest, MatchesSequentialScan) {
+  std::string text;
+  for (int i = 0; i < 50; ++i) {
+    text += kProgram;
+  }
+  const std::vector<TokenValue> expected = ScanSequentially(text);
+  // Chunks as small as one character split the text at every line.
+  for (const size_t chunk_size : {size_t(1), size_t(7), size_t(100),
+                                  text.size()}) {
+    for (const int num_threads : {1, 3, 8}) {
+      ParallelScanner scanner(text.data(), text.size(), num_threads,
+                              chunk_size);
+      EXPECT_EQ(scanner.values(), expected)
+          << "chunk_size=" << chunk_size << " num_threads=" << num_threads;
+      EXPECT_EQ(scanner.interner()->size(), 5u);
+    }
+  }
+}
+
+TEST(ParallelScannerTest, NoTrailingNewLine) {
+  const std::string text = "a := b\n+ c\nprint d";
+  const std::vector<TokenValue> expected = ScanSequentially(text);
+  ParallelScanner scanner(text.data(), text.size(), 4, 1);
+  EXPECT_EQ(scanner.values(), expected);
+}
+
+TEST(ParallelScannerTest, EmptyText) {
+  for (const std::string text : {"", "\n\n", "  # Comment only\n"}) {
+    ParallelScanner scanner(text.data(), text.size(), 4, 1);
+    ASSERT_EQ(scanner.values().size(), 1u);
+    EXPECT_EQ(scanner.values().front().type, TokenType::kEOF);
+    EXPECT_EQ(scanner.values().front().offset, text.size());
+  }
+}
+
+TEST(ParallelScannerTest, NextTokenMatchesScanner) {
+  const std::string text = kProgram;
+  Scanner expected(std::make_unique<MemoryBuffer>(text.data(), text.size()));
+  ParallelScanner scanner(text.data(), text.size(), 2, 1);
+  TokenHandle token;
+  do {
+    token = scanner.NextToken();
+    EXPECT_EQ(token->DebugString(), expected.NextToken()->DebugString());
+  } while (token->GetTokenType() != TokenType::kEOF);
+
+  // The EOF token is returned repeatedly.
+  EXPECT_EQ(scanner.NextTokenValue().type, TokenType::kEOF);
+  EXPECT_EQ(scanner.NextToken()->GetTokenType(), TokenType::kEOF);
+}
+
+TEST(ParallelScannerTest, Lexeme) {
+  const std::string text = "foo :=\n  bar12 + 345";
+  ParallelScanner scanner(text.data(), text.size(), 2, 1);
+  std::vector<std::string> lexemes;
+  while (scanner.NextTokenValue().type != TokenType::kEOF) {
+    lexemes.push_back(scanner.Lexeme().ToString());
+  }
+  EXPECT_EQ(lexemes,
+            std::vector<std::string>({"foo", ":=", "bar12", "+", "345"}));
+}
+
+TEST(ParallelScannerTest, NumberValues) {
+  std::string text;
+  for (int i = 0; i < 20; ++i) {
+    text += kProgram;
+    text += "a := " + std::to_string(i) + "00000000000000000;\n";
+  }
+  Scanner expected(std::make_unique<MemoryBuffer>(text.data(), text.size()));
+  const TokenStream stream = expected.TokenizeAll();
+  ParallelScanner scanner(text.data(), text.size(), 3, 1);
+  ASSERT_EQ(scanner.numbers().size(), stream.number_count());
+  for (size_t k = 0; k < stream.number_count(); ++k) {
+    EXPECT_EQ(scanner.numbers()[k], stream.number(k)) << "number " << k;
+  }
+
+  size_t k = 0;
+  for (TokenValue value = scanner.NextTokenValue();
+       value.type != TokenType::kEOF; value = scanner.NextTokenValue()) {
+    if (value.type == TokenType::kNumber) {
+      EXPECT_EQ(scanner.NumberValue(), stream.number(k++));
+    }
+  }
+  EXPECT_EQ(k, stream.number_count());
+}
+
+TEST(ParallelScannerTest, ScanFile) {
+  const std::string filename = WriteTemporaryFile(kProgram);
+  ParallelScanner scanner(filename, 2, 1);
+  EXPECT_EQ(scanner.values(), ScanSequentially(kProgram));
+  unlink(filename.c_str());
+}
+
+TEST(ParallelScannerDeathTest, ErrorLocationInLaterChunk) {
+  std::string text;
+  for (int i = 1; i <= 60; ++i) {
+    text += i == 51 ? "a := F;\n" : "a := 1;\n";
+  }
+  // Every line is a chunk of its own; the location counts from the start of
+  // the text, not of the chunk.
+  ASSERT_EXIT(ParallelScanner(text.data(), text.size(), 4, 1),
+              ::testing::ExitedWithCode(EXIT_FAILURE),
+              "Invalid character: F at line 51, column 6");
+
+  text.replace(text.find("F"), 1, "99999999999999999999");
+  ASSERT_EXIT(ParallelScanner(text.data(), text.size(), 4, 1),
+              ::testing::ExitedWithCode(EXIT_FAILURE),
+              "Integer literal out of range: 99999999999999999999 at line 51, "
+              "column 6");
+}
+
+TEST(ParallelScannerDeathTest, ReportsFirstErrorOfText) {
+  std::string text;
+  for (int i = 1; i <= 60; ++i) {
+    text += i == 20 || i == 51 ? "a := F;\n" : "a := 1;\n";
+  }
+  text.replace(text.find("F"), 1, "99999999999999999999");
+  // Whichever chunk a thread scans first, the error of line 20 is reported.
+  for (const int num_threads : {1, 2, 8}) {
+    ASSERT_EXIT(ParallelScanner(text.data(), text.size(), num_threads, 1),
+                ::testing::ExitedWithCode(EXIT_FAILURE),
+                "Integer literal out of range: 99999999999999999999 at line "
+                "20, column 6");
+  }
+}
+
+}  // namespace
+}  // namespace truplc
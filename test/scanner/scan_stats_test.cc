@@ -0,0 +1,69 @@
+// Unit tests for ScanStats class.
+// Copyright 2016 Hieu Le.
+
+#include "scanner/scan_stats.h"
+
+#include "gtest/gtest.h"
+
+namespace truplc {
+namespace {
+
+TEST(ScanStatsTest, Empty) {
+  const ScanStats stats;
+  EXPECT_EQ(stats.total_tokens(), 0u);
+  EXPECT_EQ(stats.tokens(TokenType::kKeyword), 0u);
+  EXPECT_EQ(stats.bytes_read(), 0u);
+  EXPECT_EQ(stats.skipped_bytes(), 0u);
+  EXPECT_EQ(stats.pushbacks(), 0u);
+  EXPECT_EQ(stats.refills(), 0u);
+}
+
+TEST(ScanStatsTest, CountAdjacentTokens) {
+  // "a:=b;" has every delimiter put back, as well as the end of input.
+  ScanStats stats;
+  stats.Count({TokenType::kIdentifier, 0, 0, 1});
+  stats.Count({TokenType::kPunctuation, 0, 1, 2});
+  stats.Count({TokenType::kIdentifier, 1, 3, 1});
+  stats.Count({TokenType::kPunctuation, 1, 4, 1});
+  stats.Count({TokenType::kEOF, 0, 5, 0});
+  for (int i = 0; i < 5; ++i) {
+    stats.CountPushback();
+  }
+  EXPECT_EQ(stats.total_tokens(), 5u);
+  EXPECT_EQ(stats.tokens(TokenType::kIdentifier), 2u);
+  EXPECT_EQ(stats.tokens(TokenType::kPunctuation), 2u);
+  EXPECT_EQ(stats.tokens(TokenType::kEOF), 1u);
+  EXPECT_EQ(stats.bytes_read(), 5u);
+  EXPECT_EQ(stats.skipped_bytes(), 0u);
+  EXPECT_EQ(stats.pushbacks(), 5u);
+}
+
+TEST(ScanStatsTest, CountSeparatedTokens) {
+  // " a # c\n b " has spaces and a comment between its tokens.
+  ScanStats stats;
+  stats.Count({TokenType::kIdentifier, 0, 1, 1});
+  stats.Count({TokenType::kIdentifier, 1, 8, 1});
+  stats.Count({TokenType::kEOF, 0, 10, 0});
+  EXPECT_EQ(stats.bytes_read(), 10u);
+  EXPECT_EQ(stats.skipped_bytes(), 8u);
+  EXPECT_EQ(stats.pushbacks(), 0u);
+
+  stats.set_refills(2);
+  EXPECT_EQ(stats.refills(), 2u);
+  EXPECT_EQ(stats.tokens(TokenType::kUnspecified), 0u);
+}
+
+TEST(ScanStatsTest, CountErrorLimit) {
+  // "a @ b" stops at the EOF token once the error on "@" fills the log. The
+  // input is read up to the error token.
+  ScanStats stats;
+  stats.Count({TokenType::kIdentifier, 0, 0, 1});
+  stats.Count({TokenType::kError, 0, 2, 1});
+  stats.CountErrorLimit();
+  stats.Count({TokenType::kEOF, 0, 4, 0});
+  EXPECT_EQ(stats.bytes_read(), 3u);
+  EXPECT_EQ(stats.skipped_bytes(), 1u);
+}
+
+}  // namespace
+}  // namespace truplc
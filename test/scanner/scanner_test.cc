@@ -3,7 +3,6 @@
 
 #include "scanner/scanner.h"
 
-#include <list>
 #include <sstream>
 #include <unordered_map>
 #include <utility>
@@ -21,25 +20,37 @@ class MockBuffer : public Buffer {
  public:
   // Input string must be in the proper format ready for processing by Scanner.
   explicit MockBuffer(const std::string& input)
-      : buffer_(input.begin(), input.end()) {}
+      : buffer_(input), cursor_(0), mark_(0) {}
 
   char NextChar() override {
-    if (buffer_.empty()) {
+    if (cursor_ == buffer_.size()) {
       return kEOFMarker;
     }
-    const char head = buffer_.front();
-    buffer_.pop_front();
-    return head;
+    return buffer_[cursor_++];
   }
 
   void UnreadChar(const char c) override {
     if (c != kEOFMarker) {
-      buffer_.push_front(c);
+      --cursor_;
     }
   }
 
+  void Mark() override {
+    mark_ = cursor_;
+  }
+
+  StringPiece Slice(const size_t length) const override {
+    return StringPiece(buffer_.data() + mark_, length);
+  }
+
+  size_t MarkOffset() const override {
+    return mark_;
+  }
+
  private:
-  std::list<char> buffer_;
+  const std::string buffer_;
+  size_t cursor_;
+  size_t mark_;
 };
 
 // Creates a character buffer from given input string.
@@ -50,7 +61,7 @@ std::unique_ptr<Buffer> CreateBuffer(const std::string& input) {
 // Checks if the token represented in input string matches expected token.
 void MatchSingleToken(const std::string& input, const Token& expected) {
   Scanner scanner(CreateBuffer(input));
-  std::unique_ptr<Token> actual = scanner.NextToken();
+  const TokenHandle actual = scanner.NextToken();
   EXPECT_EQ(actual->DebugString(), expected.DebugString());
   EXPECT_EQ(scanner.NextToken()->DebugString(), ENDOFFILE.DebugString());
 }
@@ -60,7 +71,7 @@ void MatchSingleToken(const std::string& input, const Token& expected) {
 void MatchTokens(const std::string& input, const std::vector<Token*>& tokens) {
   Scanner scanner(CreateBuffer(input));
   for (const auto& token : tokens) {
-    std::unique_ptr<Token> actual = scanner.NextToken();
+    const TokenHandle actual = scanner.NextToken();
     std::unique_ptr<Token> expected(token);
     EXPECT_EQ(actual->DebugString(), expected->DebugString());
   }
@@ -237,6 +248,253 @@ TEST(ScannerTest, StressTest) {
   MatchTokens(input, expected);
 }
 
+TEST(ScannerTest, TokenizeAll) {
+  const std::string input = "if a1 <> 12 then print a1; end if;";
+  Scanner expected_scanner(CreateBuffer(input));
+  std::vector<TokenValue> expected;
+  do {
+    expected.push_back(expected_scanner.NextTokenValue());
+  } while (expected.back().type != TokenType::kEOF);
+
+  Scanner scanner(CreateBuffer(input));
+  const TokenStream stream = scanner.TokenizeAll();
+  ASSERT_EQ(stream.size(), expected.size());
+  for (size_t i = 0; i < stream.size(); ++i) {
+    EXPECT_EQ(stream[i], expected[i]) << "token " << i;
+  }
+  EXPECT_EQ(stream.type(2), TokenType::kRelOperator);
+  EXPECT_EQ(stream.offset(3), 9u);
+  EXPECT_EQ(stream.length(3), 2u);
+  EXPECT_EQ(stream.attribute(1), stream.attribute(6));
+}
+
+TEST(ScannerTest, TokenizeIntoBatches) {
+  const std::string input = "a := b + c; print a;";
+  Scanner expected_scanner(CreateBuffer(input));
+  const TokenStream expected = expected_scanner.TokenizeAll();
+  ASSERT_EQ(expected.size(), 10u);
+
+  Scanner scanner(CreateBuffer(input));
+  TokenStream stream;
+  EXPECT_EQ(scanner.TokenizeInto(&stream, 4), 4u);
+  EXPECT_EQ(scanner.TokenizeInto(&stream, 4), 4u);
+  // The last batch stops after the EOF token.
+  EXPECT_EQ(scanner.TokenizeInto(&stream, 4), 2u);
+  ASSERT_EQ(stream.size(), expected.size());
+  for (size_t i = 0; i < stream.size(); ++i) {
+    EXPECT_EQ(stream[i], expected[i]) << "token " << i;
+  }
+  EXPECT_EQ(scanner.TokenizeInto(&stream, 0), 0u);
+
+  stream.clear();
+  EXPECT_TRUE(stream.empty());
+}
+
+TEST(ScannerTest, SourceManager) {
+  // Streamed input is not kept in memory.
+  Scanner stream_scanner(CreateBuffer("a := b"));
+  EXPECT_EQ(stream_scanner.source_manager(), nullptr);
+
+  const std::string input = "program foo;\n  a := 12;";
+  Scanner scanner(std::make_unique<MemoryBuffer>(input.data(), input.size()));
+  ASSERT_NE(scanner.source_manager(), nullptr);
+  TokenValue value;
+  do {
+    value = scanner.NextTokenValue();
+  } while (value.type != TokenType::kNumber);
+  const SourceLocation location =
+      scanner.source_manager()->Locate(value.offset);
+  EXPECT_EQ(location.line, 2u);
+  EXPECT_EQ(location.column, 8u);
+}
+
+TEST(ScannerTest, ScansCallerOwnedText) {
+  const std::string input = "program foo; a := 12;";
+  Scanner scanner(input.data(), input.size());
+  ASSERT_NE(scanner.source_manager(), nullptr);
+  const TokenStream stream = scanner.TokenizeAll();
+  ASSERT_EQ(stream.size(), 8u);
+  EXPECT_EQ(stream.type(5), TokenType::kNumber);
+  EXPECT_EQ(stream.type(7), TokenType::kEOF);
+
+  // Lexemes are sliced out of the caller's text.
+  Scanner lexeme_scanner(input.data(), input.size());
+  lexeme_scanner.NextTokenValue();
+  lexeme_scanner.NextTokenValue();
+  EXPECT_EQ(lexeme_scanner.Lexeme().data(), input.data() + 8);
+}
+
+TEST(ScannerTest, ErrorRecovery) {
+  const std::string input = "program foo;\n  a := 1 % 2;\n  b := F;";
+  Scanner scanner(std::make_unique<MemoryBuffer>(input.data(), input.size()));
+  EXPECT_EQ(scanner.error_log(), nullptr);
+  scanner.EnableErrorRecovery();
+  const TokenStream stream = scanner.TokenizeAll();
+  EXPECT_EQ(stream.size(), 14u);
+  EXPECT_EQ(stream.type(6), TokenType::kError);
+  EXPECT_EQ(stream.type(13), TokenType::kEOF);
+
+  const LexicalErrorLog* log = scanner.error_log();
+  ASSERT_NE(log, nullptr);
+  ASSERT_EQ(log->size(), 2u);
+  EXPECT_EQ(log->errors()[0].message, "Invalid character: %");
+  EXPECT_EQ(scanner.source_manager()->Describe(log->errors()[0].offset),
+            " at line 2, column 10");
+  EXPECT_EQ(log->errors()[1].message, "Invalid character: F");
+  EXPECT_EQ(scanner.source_manager()->Describe(log->errors()[1].offset),
+            " at line 3, column 8");
+}
+
+TEST(ScannerTest, IntegerLiteralOutOfRange) {
+  const std::string input =
+      "a := 9223372036854775807; b := 9223372036854775808;\n"
+      "c := 000000000000000000001;";
+  Scanner scanner(input.data(), input.size());
+  scanner.EnableErrorRecovery();
+  const TokenStream stream = scanner.TokenizeAll();
+  ASSERT_EQ(stream.size(), 13u);
+  EXPECT_EQ(stream.type(2), TokenType::kNumber);
+  EXPECT_EQ(stream.type(6), TokenType::kError);
+  EXPECT_EQ(stream.type(7), TokenType::kPunctuation);
+  EXPECT_EQ(stream.type(10), TokenType::kNumber);
+
+  const LexicalErrorLog* log = scanner.error_log();
+  ASSERT_EQ(log->size(), 1u);
+  EXPECT_EQ(log->errors()[0].message,
+            "Integer literal out of range: 9223372036854775808");
+  EXPECT_EQ(scanner.source_manager()->Describe(log->errors()[0].offset),
+            " at line 1, column 32");
+}
+
+TEST(ScannerTest, NumberTokenValue) {
+  const std::string input = "x := 1234567890123;";
+  Scanner scanner(input.data(), input.size());
+  scanner.NextToken();
+  scanner.NextToken();
+  const TokenHandle number = scanner.NextToken();
+  EXPECT_EQ(static_cast<const NumberToken&>(*number).GetValue(),
+            1234567890123);
+  EXPECT_EQ(scanner.NumberValue(), 1234567890123);
+}
+
+TEST(ScannerTest, TokenizeIntoNumberValues) {
+  const std::string input = "a := 007 + b * 9223372036854775807 - 12;";
+  Scanner scanner(CreateBuffer(input));
+  const TokenStream stream = scanner.TokenizeAll();
+  ASSERT_EQ(stream.number_count(), 3u);
+  EXPECT_EQ(stream.number(0), 7);
+  EXPECT_EQ(stream.number(1), 9223372036854775807);
+  EXPECT_EQ(stream.number(2), 12);
+}
+
+TEST(ScannerTest, ErrorLimit) {
+  Scanner scanner(CreateBuffer("a ! b ! c"));
+  scanner.EnableErrorRecovery(1);
+  EXPECT_EQ(scanner.NextToken()->DebugString(), "kIdentifier:a");
+  EXPECT_EQ(scanner.NextToken()->DebugString(), "kError:!");
+  EXPECT_EQ(scanner.NextToken()->GetTokenType(), TokenType::kEOF);
+  EXPECT_EQ(scanner.error_log()->size(), 1u);
+}
+
+TEST(ScannerTest, NextTokenSharesFixedTokens) {
+  const std::string input = "begin x := x; begin";
+  Scanner scanner(input.data(), input.size());
+  const TokenHandle begin = scanner.NextToken();
+  const TokenHandle identifier = scanner.NextToken();
+  EXPECT_FALSE(begin.owned());
+  EXPECT_TRUE(identifier.owned());
+  scanner.NextToken();
+  scanner.NextToken();
+  scanner.NextToken();
+  EXPECT_EQ(scanner.NextToken().get(), begin.get());
+  EXPECT_FALSE(scanner.NextToken().owned());
+}
+
+TEST(ScannerTest, AllocatesTokensInArena) {
+  std::istringstream input("x := 12 $ ;");
+  Arena arena;
+  Scanner scanner(std::make_unique<StreamBuffer>(&input, 4));
+  scanner.EnableErrorRecovery();
+  scanner.UseArena(&arena);
+  const TokenHandle identifier = scanner.NextToken();
+  EXPECT_FALSE(identifier.owned());
+  EXPECT_EQ(identifier->DebugString(), "kIdentifier:x");
+  scanner.NextToken();
+  const size_t bytes_used = arena.bytes_used();
+  const TokenHandle number = scanner.NextToken();
+  EXPECT_FALSE(number.owned());
+  EXPECT_GT(arena.bytes_used(), bytes_used);
+  const TokenHandle error = scanner.NextToken();
+  EXPECT_FALSE(error.owned());
+  EXPECT_EQ(error->DebugString(), "kError:$");
+
+  // The number is copied out of the stream buffer into the arena.
+  scanner.TokenizeAll();
+  EXPECT_EQ(number->DebugString(), "kNumber:12");
+}
+
+TEST(ScannerTest, Stats) {
+  const std::string input = "program foo; # Comment\n  a:=12;\n";
+  Scanner scanner(input.data(), input.size());
+  EXPECT_EQ(scanner.stats().total_tokens(), 0u);
+
+  // Tokens are counted from the call on.
+  EXPECT_EQ(scanner.NextToken()->DebugString(), "kKeyword:kProgram");
+  scanner.EnableStats();
+  EXPECT_EQ(scanner.NextToken()->DebugString(), "kIdentifier:foo");
+  scanner.TokenizeAll();
+  const ScanStats stats = scanner.stats();
+  EXPECT_EQ(stats.total_tokens(), 7u);
+  EXPECT_EQ(stats.tokens(TokenType::kKeyword), 0u);
+  EXPECT_EQ(stats.tokens(TokenType::kIdentifier), 2u);
+  EXPECT_EQ(stats.tokens(TokenType::kPunctuation), 3u);
+  EXPECT_EQ(stats.tokens(TokenType::kNumber), 1u);
+  EXPECT_EQ(stats.tokens(TokenType::kEOF), 1u);
+  EXPECT_EQ(stats.bytes_read(), input.size());
+  // The delimiters after "foo", "a", ":=" and "12" are put back, and so is
+  // the end of input.
+  EXPECT_EQ(stats.pushbacks(), 5u);
+  EXPECT_EQ(stats.refills(), 0u);
+}
+
+TEST(ScannerTest, StreamStats) {
+  std::istringstream input("a := b + 1;\nc := a * 2;\n");
+  Scanner scanner(std::make_unique<StreamBuffer>(&input, 4));
+  scanner.EnableStats();
+  scanner.TokenizeAll();
+  const ScanStats stats = scanner.stats();
+  EXPECT_EQ(stats.total_tokens(), 13u);
+  EXPECT_EQ(stats.bytes_read(), 24u);
+  EXPECT_EQ(stats.skipped_bytes(), 10u);
+  EXPECT_EQ(stats.refills(), 6u);
+}
+
+TEST(ScannerTest, StatsCountPushbacks) {
+  // Every delimiter but a space is put back, including the end of input.
+  const std::pair<std::string, uint64_t> kInputs[] = {
+      {"a:=b;", 5}, {"a := b ; ", 1}, {"begin\nend", 2},
+      {"a:=b+1;#c\nif(a<>2)then", 13}};
+  for (const auto& input : kInputs) {
+    Scanner scanner(input.first.data(), input.first.size());
+    scanner.EnableStats();
+    scanner.TokenizeAll();
+    EXPECT_EQ(scanner.stats().pushbacks(), input.second) << input.first;
+  }
+}
+
+TEST(ScannerTest, StatsStopAtErrorLimit) {
+  // Scanning stops after the first error, once "@" has been read.
+  const std::string input = "a @ b @ c := d;";
+  Scanner scanner(input.data(), input.size());
+  scanner.EnableErrorRecovery(1);
+  scanner.EnableStats();
+  scanner.TokenizeAll();
+  const ScanStats stats = scanner.stats();
+  EXPECT_EQ(stats.total_tokens(), 3u);
+  EXPECT_EQ(stats.bytes_read(), 3u);
+  EXPECT_EQ(stats.skipped_bytes(), 1u);
+}
+
 TEST(ScannerDeathTest, ScanIllegalCharacter) {
   {
     Scanner scanner(CreateBuffer("%"));
@@ -258,6 +516,12 @@ TEST(ScannerDeathTest, ScanIllegalCharacter) {
                 ::testing::ExitedWithCode(EXIT_FAILURE),
                 "c*Illegal character: H*");
   }
+  {
+    Scanner scanner(CreateBuffer("99999999999999999999"));
+    ASSERT_EXIT(scanner.NextToken(),
+                ::testing::ExitedWithCode(EXIT_FAILURE),
+                "c*Integer literal out of range: 99999999999999999999*");
+  }
 }
 
 }  // namespace
@@ -0,0 +1,79 @@
+// Unit tests for SourceManager class.
+// Copyright 2016 Hieu Le.
+
+#include "scanner/source_manager.h"
+
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace truplc {
+namespace {
+
+// Checks the location of the character at a given offset.
+void ExpectLocation(const SourceManager& source_manager, const size_t offset,
+                    const uint32_t line, const uint32_t column) {
+  const SourceLocation location = source_manager.Locate(offset);
+  EXPECT_EQ(location.line, line) << "offset " << offset;
+  EXPECT_EQ(location.column, column) << "offset " << offset;
+}
+
+TEST(SourceManagerTest, Locate) {
+  const std::string text = "program foo;\n\n  a: int;\nbegin";
+  const SourceManager source_manager(text);
+  ExpectLocation(source_manager, 0, 1, 1);
+  ExpectLocation(source_manager, 8, 1, 9);
+  ExpectLocation(source_manager, 12, 1, 13);  // New line ending line 1.
+  ExpectLocation(source_manager, 13, 2, 1);
+  ExpectLocation(source_manager, 16, 3, 3);
+  ExpectLocation(source_manager, 24, 4, 1);
+  ExpectLocation(source_manager, text.size(), 4, 6);
+  ExpectLocation(source_manager, text.size() + 10, 4, 6);
+}
+
+TEST(SourceManagerTest, Line) {
+  const std::string text = "program foo;\n\n  a: int;\nbegin";
+  const SourceManager source_manager(text);
+  ASSERT_EQ(source_manager.line_count(), 4u);
+  EXPECT_EQ(source_manager.Line(1).ToString(), "program foo;");
+  EXPECT_EQ(source_manager.Line(2).ToString(), "");
+  EXPECT_EQ(source_manager.Line(3).ToString(), "  a: int;");
+  EXPECT_EQ(source_manager.Line(4).ToString(), "begin");
+}
+
+TEST(SourceManagerTest, TrailingNewLine) {
+  const std::string text = "a\nb\n";
+  const SourceManager source_manager(text);
+  EXPECT_EQ(source_manager.line_count(), 2u);
+  ExpectLocation(source_manager, 3, 2, 2);
+  ExpectLocation(source_manager, text.size(), 3, 1);
+}
+
+TEST(SourceManagerTest, EmptyText) {
+  const SourceManager source_manager(StringPiece("", 0));
+  EXPECT_EQ(source_manager.line_count(), 1u);
+  ExpectLocation(source_manager, 0, 1, 1);
+}
+
+TEST(SourceManagerTest, Describe) {
+  const std::string text = "a := b\n  + %";
+  const SourceManager source_manager(text);
+  EXPECT_EQ(source_manager.Describe(11), " at line 2, column 5");
+}
+
+TEST(SourceManagerTest, ManyLines) {
+  std::string text;
+  for (int i = 0; i < 1000; ++i) {
+    text += std::string(i % 37, 'x') + "\n";
+  }
+  const SourceManager source_manager(text);
+  EXPECT_EQ(source_manager.line_count(), 1000u);
+  size_t offset = 0;
+  for (uint32_t line = 1; line <= 1000; ++line) {
+    ExpectLocation(source_manager, offset, line, 1);
+    offset += source_manager.Line(line).size() + 1;
+  }
+}
+
+}  // namespace
+}  // namespace truplc
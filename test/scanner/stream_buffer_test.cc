@@ -4,22 +4,29 @@
 #include "scanner/stream_buffer.h"
 
 #include <sstream>
+#include <string>
 #include <utility>
 #include <vector>
 
+#include "scanner/char_class.h"
+
 #include "gtest/gtest.h"
 
 namespace truplc {
 namespace {
 
 // Test if StreamBuffer generates on specified input an expected sequence of
-// characters.
+// characters. Small buffer sizes are exercised as well so that every refill
+// boundary is crossed.
 void TestNextChar(const std::string& input,
                   const std::vector<char>& expected) {
-  std::istringstream ss(input);
-  StreamBuffer buffer(&ss);
-  for (const char c : expected) {
-    EXPECT_EQ(buffer.NextChar(), c);
+  for (const size_t buffer_size : {size_t{1}, size_t{2}, size_t{7},
+                                   StreamBuffer::kMaxBufferSize}) {
+    std::istringstream ss(input);
+    StreamBuffer buffer(&ss, buffer_size);
+    for (const char c : expected) {
+      EXPECT_EQ(buffer.NextChar(), c) << "buffer size: " << buffer_size;
+    }
   }
 }
 
@@ -102,6 +109,72 @@ TEST(StreamBufferTest, NextCharWithLongInputStream) {
   }
 }
 
+// Splits the content of a buffer into lexemes the way the scanner does: each
+// lexeme is marked, read up to and including its delimiter, then sliced.
+// Records the offset of each lexeme if offsets is not null.
+std::vector<std::string> ReadLexemes(Buffer* buffer,
+                                     std::vector<size_t>* offsets = nullptr) {
+  std::vector<std::string> lexemes;
+  for (;;) {
+    buffer->Mark();
+    char c = buffer->NextChar();
+    if (c == kEOFMarker) {
+      return lexemes;
+    }
+    if (offsets != nullptr) {
+      offsets->push_back(buffer->MarkOffset());
+    }
+    size_t length = 1;
+    if (IsAlphanumeric(c)) {
+      while (IsAlphanumeric(c = buffer->NextChar())) {
+        ++length;
+      }
+      if (c != kSpace) {
+        buffer->UnreadChar(c);
+      }
+    } else if ((c = buffer->NextChar()) != kSpace) {
+      buffer->UnreadChar(c);
+    }
+    lexemes.push_back(buffer->Slice(length).ToString());
+  }
+}
+
+TEST(StreamBufferTest, SliceAcrossRefill) {
+  const std::string input =
+      "abc def;#comment that spans many blocks\n\t ghijklmnop0123 9(x)  ";
+  const std::vector<std::string> expected =
+      {"abc", "def", ";", "ghijklmnop0123", "9", "(", "x", ")"};
+  for (const size_t buffer_size : {size_t{1}, size_t{2}, size_t{7},
+                                   StreamBuffer::kMaxBufferSize}) {
+    std::istringstream ss(input);
+    StreamBuffer buffer(&ss, buffer_size);
+    EXPECT_FALSE(buffer.HasStableSlices());
+    EXPECT_EQ(ReadLexemes(&buffer), expected) << "buffer size: " << buffer_size;
+  }
+}
+
+TEST(StreamBufferTest, SliceLongerThanBuffer) {
+  const std::string identifier(20000, 'a');
+  std::istringstream ss(identifier + " " + identifier + ";");
+  StreamBuffer buffer(&ss, 7);
+  EXPECT_EQ(ReadLexemes(&buffer),
+            std::vector<std::string>({identifier, identifier, ";"}));
+}
+
+TEST(StreamBufferTest, MarkOffsetAcrossRefill) {
+  const std::string input =
+      "  abc def;#comment that spans many blocks\n\t ghijklmnop0123 9(x)  ";
+  const std::vector<size_t> expected = {2, 6, 9, 44, 59, 60, 61, 62};
+  for (const size_t buffer_size : {size_t{1}, size_t{2}, size_t{7},
+                                   StreamBuffer::kMaxBufferSize}) {
+    std::istringstream ss(input);
+    StreamBuffer buffer(&ss, buffer_size);
+    std::vector<size_t> offsets;
+    ReadLexemes(&buffer, &offsets);
+    EXPECT_EQ(offsets, expected) << "buffer size: " << buffer_size;
+  }
+}
+
 TEST(StreamBufferTest, UnreadCharBasic) {
   std::istringstream ss("a");
   StreamBuffer buffer(&ss);
@@ -114,6 +187,53 @@ TEST(StreamBufferTest, UnreadCharBasic) {
   EXPECT_EQ(buffer.NextChar(), kEOFMarker);
 }
 
+TEST(StreamBufferTest, UnreadCharAcrossRefill) {
+  std::istringstream ss("ab #comment\n\t cd");
+  StreamBuffer buffer(&ss, 1);
+  EXPECT_EQ(buffer.NextChar(), 'a');
+  EXPECT_EQ(buffer.NextChar(), 'b');
+  buffer.UnreadChar('b');
+  EXPECT_EQ(buffer.NextChar(), 'b');
+  EXPECT_EQ(buffer.NextChar(), kSpace);
+  buffer.UnreadChar(kSpace);
+  EXPECT_EQ(buffer.NextChar(), kSpace);
+  EXPECT_EQ(buffer.NextChar(), 'c');
+  buffer.UnreadChar('c');
+  EXPECT_EQ(buffer.NextChar(), 'c');
+  EXPECT_EQ(buffer.NextChar(), 'd');
+  EXPECT_EQ(buffer.NextChar(), kEOFMarker);
+}
+
+TEST(StreamBufferTest, UnreadSpaceAtEndOfStream) {
+  std::istringstream ss("a #comment");
+  StreamBuffer buffer(&ss);
+  EXPECT_EQ(buffer.NextChar(), 'a');
+  EXPECT_EQ(buffer.NextChar(), kSpace);
+  buffer.UnreadChar(kSpace);
+  EXPECT_EQ(buffer.NextChar(), kSpace);
+  EXPECT_EQ(buffer.NextChar(), kEOFMarker);
+}
+
+TEST(StreamBufferTest, RecoversInvalidChars) {
+  for (const size_t buffer_size : {size_t{1}, size_t{2}, size_t{7}}) {
+    std::istringstream ss("aF$ #!\n%");
+    StreamBuffer buffer(&ss, buffer_size);
+    buffer.set_recover_invalid_chars(true);
+    buffer.Mark();
+    EXPECT_EQ(buffer.NextChar(), 'a');
+    EXPECT_EQ(buffer.NextChar(), kInvalidMarker);
+    buffer.UnreadChar(kInvalidMarker);
+    EXPECT_EQ(buffer.NextChar(), kInvalidMarker);
+    EXPECT_EQ(buffer.NextChar(), kInvalidMarker);
+    // Unreading an invalid character keeps the original one in the lexeme.
+    EXPECT_EQ(buffer.Slice(3).ToString(), "aF$")
+        << "buffer size: " << buffer_size;
+    EXPECT_EQ(buffer.NextChar(), kSpace);
+    EXPECT_EQ(buffer.NextChar(), kInvalidMarker);
+    EXPECT_EQ(buffer.NextChar(), kEOFMarker);
+  }
+}
+
 TEST(StreamBufferDeathTest, NextCharIllegalInput) {
   {
     std::istringstream ss("FOO");
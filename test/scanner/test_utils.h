@@ -5,6 +5,8 @@
 #ifndef TRUPLC_SCANNER_TEST_UTILS_H__
 #define TRUPLC_SCANNER_TEST_UTILS_H__
 
+#include <string>
+
 #include "tokens/add_operator_token.h"
 #include "tokens/eof_token.h"
 #include "tokens/identifier_token.h"
@@ -58,7 +60,7 @@
 
 // Identifiers and numbers.
 #define IDENTIFIER(id) IdentifierToken(id)
-#define NUMBER(num)    NumberToken(num)
+#define NUMBER(num)    NumberToken(std::string(num), std::stoll(num))
 
 // EOF
 #define ENDOFFILE EOFToken()
@@ -0,0 +1,244 @@
+// Unit tests for TokenCache class.
+// Copyright 2016 Hieu Le.
+
+#include "scanner/token_cache.h"
+
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "scanner/scanner.h"
+
+#include "gtest/gtest.h"
+
+namespace truplc {
+namespace {
+
+const char kProgram[] =
+    "program foo;\n"
+    "  a, b: int;\n"
+    "begin\n"
+    "  a := 12 * (b - 3);\n"
+    "  print a;\n"
+    "end;";
+
+// Temporary cache directory, removed with the files it holds.
+class TokenCacheTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    char name[] = "/tmp/token_cache_test.XXXXXX";
+    directory_ = mkdtemp(name);
+  }
+
+  void TearDown() override {
+    for (const std::string& path : paths_) {
+      std::remove(path.c_str());
+    }
+    rmdir(directory_.c_str());
+  }
+
+  // Scans a text into a stream, interning names into a scanner's pool, and
+  // stores the tokens into a cache.
+  void ScanAndStore(const std::string& text, TokenCache* cache,
+                    TokenStream* stream) {
+    Scanner scanner(text.data(), text.size());
+    *stream = scanner.TokenizeAll();
+    ASSERT_TRUE(cache->Store(text, *stream, *scanner.interner()));
+    paths_.push_back(cache->PathFor(text));
+  }
+
+  // Returns the content of a file.
+  static std::string ReadFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(file),
+                       std::istreambuf_iterator<char>());
+  }
+
+  // Replaces the content of a file.
+  static void WriteFile(const std::string& path, const std::string& content) {
+    std::ofstream(path, std::ios::binary) << content;
+  }
+
+  std::string directory_;
+  std::vector<std::string> paths_;
+};
+
+TEST_F(TokenCacheTest, ReplaysStoredTokens) {
+  const std::string text = kProgram;
+  TokenCache cache(directory_);
+  TokenStream stream;
+  StringInterner interner;
+  EXPECT_FALSE(cache.Lookup(text, &stream, &interner));
+  EXPECT_EQ(cache.misses(), 1u);
+
+  TokenStream expected;
+  ScanAndStore(text, &cache, &expected);
+  ASSERT_TRUE(cache.Lookup(text, &stream, &interner));
+  EXPECT_EQ(cache.hits(), 1u);
+  ASSERT_EQ(stream.size(), expected.size());
+  for (size_t i = 0; i < stream.size(); ++i) {
+    EXPECT_EQ(stream[i], expected[i]) << "token " << i;
+  }
+  ASSERT_EQ(stream.number_count(), 2u);
+  EXPECT_EQ(stream.number(0), 12);
+  EXPECT_EQ(stream.number(1), 3);
+  ASSERT_EQ(interner.size(), 3u);
+  EXPECT_EQ(interner.Lookup(0).ToString(), "foo");
+  EXPECT_EQ(interner.Lookup(2).ToString(), "b");
+}
+
+TEST_F(TokenCacheTest, RemovesTemporaryFileOnFailedRename) {
+  const std::string text = kProgram;
+  TokenCache cache(directory_);
+  Scanner scanner(text.data(), text.size());
+  const TokenStream stream = scanner.TokenizeAll();
+
+  // A directory in place of the cache file cannot be replaced by a file.
+  const std::string path = cache.PathFor(text);
+  ASSERT_EQ(mkdir(path.c_str(), 0700), 0);
+  const std::string child = path + "/file";
+  std::ofstream(child) << "x";
+  EXPECT_FALSE(cache.Store(text, stream, *scanner.interner()));
+  const std::string temporary_path = path + "." + std::to_string(getpid());
+  EXPECT_NE(access(temporary_path.c_str(), F_OK), 0);
+  std::remove(child.c_str());
+  rmdir(path.c_str());
+}
+
+TEST_F(TokenCacheTest, MissesOnChangedText) {
+  const std::string text = kProgram;
+  TokenCache cache(directory_);
+  TokenStream stream;
+  ScanAndStore(text, &cache, &stream);
+
+  std::string changed = text;
+  changed[changed.find("12")] = '3';
+  StringInterner interner;
+  EXPECT_NE(cache.PathFor(changed), cache.PathFor(text));
+  EXPECT_FALSE(cache.Lookup(changed, &stream, &interner));
+  EXPECT_EQ(cache.misses(), 1u);
+}
+
+TEST_F(TokenCacheTest, IgnoresCorruptFile) {
+  const std::string text = kProgram;
+  TokenCache cache(directory_);
+  TokenStream stream;
+  ScanAndStore(text, &cache, &stream);
+
+  // A truncated file is a miss.
+  std::string image;
+  {
+    std::ifstream file(cache.PathFor(text), std::ios::binary);
+    image.assign(std::istreambuf_iterator<char>(file),
+                 std::istreambuf_iterator<char>());
+  }
+  std::ofstream(cache.PathFor(text), std::ios::binary)
+      << image.substr(0, image.size() - 1);
+  StringInterner interner;
+  EXPECT_FALSE(cache.Lookup(text, &stream, &interner));
+
+  // So is a file of another version.
+  image[8] = static_cast<char>(TokenCache::kVersion + 1);
+  std::ofstream(cache.PathFor(text), std::ios::binary) << image;
+  EXPECT_FALSE(cache.Lookup(text, &stream, &interner));
+  EXPECT_EQ(cache.misses(), 2u);
+  EXPECT_EQ(cache.hits(), 0u);
+}
+
+TEST_F(TokenCacheTest, MissesOnCorruptPayload) {
+  const std::string text = kProgram;
+  TokenCache cache(directory_);
+  TokenStream expected;
+  ScanAndStore(text, &cache, &expected);
+  const std::string path = cache.PathFor(text);
+  const std::string image = ReadFile(path);
+
+  // Offsets of the arrays that follow the 56-byte header.
+  const size_t count = expected.size();
+  const size_t types = 56;
+  const size_t attributes = types + (count + 3) / 4 * 4;
+  const size_t offsets = attributes + 4 * count;
+  const size_t lengths = offsets + 4 * count;
+  const size_t name_lengths =
+      lengths + 4 * count + 8 * expected.number_count();
+  size_t identifier = 0;
+  while (expected.type(identifier) != TokenType::kIdentifier) {
+    ++identifier;
+  }
+
+  std::vector<std::string> corrupt;
+  // A type byte outside the range of token types.
+  corrupt.push_back(image);
+  corrupt.back()[types] = 42;
+  // A number token more than the cached number values.
+  corrupt.push_back(image);
+  corrupt.back()[types + identifier] = static_cast<char>(TokenType::kNumber);
+  // No kEOF token at the end.
+  corrupt.push_back(image);
+  corrupt.back()[types + count - 1] =
+      static_cast<char>(TokenType::kPunctuation);
+  // A second kEOF token.
+  corrupt.push_back(image);
+  corrupt.back()[types] = static_cast<char>(TokenType::kEOF);
+  // An identifier naming none of the cached names.
+  corrupt.push_back(image);
+  corrupt.back()[attributes + 4 * identifier] = 3;
+  // A keyword that does not exist.
+  ASSERT_EQ(expected.type(0), TokenType::kKeyword);
+  corrupt.push_back(image);
+  corrupt.back()[attributes] = 99;
+  // A punctuation token whose attribute is that of no punctuation.
+  size_t punctuation = 0;
+  while (expected.type(punctuation) != TokenType::kPunctuation) {
+    ++punctuation;
+  }
+  corrupt.push_back(image);
+  corrupt.back()[attributes + 4 * punctuation + 3] = '\x7f';
+  // An error token with a negative index.
+  corrupt.push_back(image);
+  corrupt.back()[types + identifier] = static_cast<char>(TokenType::kError);
+  corrupt.back()[attributes + 4 * identifier + 3] = '\xff';
+  // A token extending past the end of the text.
+  corrupt.push_back(image);
+  corrupt.back()[offsets + 4 * (count - 1)] += 1;
+  corrupt.push_back(image);
+  corrupt.back()[lengths + 4 * (count - 2)] = 100;
+  // Name lengths that do not add up to the name characters.
+  corrupt.push_back(image);
+  corrupt.back()[name_lengths] += 1;
+  // Name lengths that add up, but repeat a name and so shift the ids.
+  corrupt.push_back(image);
+  corrupt.back()[corrupt.back().size() - 1] = 'a';
+
+  for (size_t i = 0; i < corrupt.size(); ++i) {
+    ASSERT_EQ(corrupt[i].size(), image.size());
+    WriteFile(path, corrupt[i]);
+    TokenStream stream;
+    StringInterner interner;
+    EXPECT_FALSE(cache.Lookup(text, &stream, &interner)) << "corruption " << i;
+    EXPECT_EQ(stream.size(), 0u);
+    EXPECT_EQ(interner.size(), 0u);
+  }
+  EXPECT_EQ(cache.misses(), corrupt.size());
+  EXPECT_EQ(cache.hits(), 0u);
+
+  // The intact file replays only into an empty interner.
+  WriteFile(path, image);
+  TokenStream stream;
+  StringInterner interner;
+  interner.Intern(std::string("foo"));
+  EXPECT_FALSE(cache.Lookup(text, &stream, &interner));
+  EXPECT_EQ(interner.size(), 1u);
+  StringInterner empty;
+  EXPECT_TRUE(cache.Lookup(text, &stream, &empty));
+  EXPECT_EQ(stream.size(), expected.size());
+}
+
+}  // namespace
+}  // namespace truplc
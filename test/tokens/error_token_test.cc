@@ -0,0 +1,32 @@
+// Unit tests for ErrorToken class.
+// Copyright 2016 Hieu Le.
+
+#include "tokens/error_token.h"
+
+#include <memory>
+
+#include "gtest/gtest.h"
+
+namespace truplc {
+namespace {
+
+TEST(ErrorTokenTest, GetTokenType) {
+  const ErrorToken token("a@b");
+  EXPECT_EQ(token.GetTokenType(), TokenType::kError);
+}
+
+TEST(ErrorTokenTest, GetLexeme) {
+  const ErrorToken default_token;
+  EXPECT_TRUE(default_token.GetLexeme().empty());
+
+  const ErrorToken specified_token("x$y");
+  EXPECT_EQ(specified_token.GetLexeme(), "x$y");
+}
+
+TEST(ErrorTokenTest, DebugString) {
+  std::unique_ptr<Token> token = std::make_unique<ErrorToken>("1a?");
+  EXPECT_EQ(token->DebugString(), "kError:1a?");
+}
+
+}  // namespace
+}  // namespace truplc
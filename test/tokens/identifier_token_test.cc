@@ -22,6 +22,27 @@ TEST(IdentifierToken, GetAttribute) {
   EXPECT_EQ(specified_token.GetAttribute(), attribute);
 }
 
+TEST(IdentifierToken, RefersToLexeme) {
+  const std::string source = "foo := bar";
+  const IdentifierToken token(StringPiece(source.data() + 7, 3));
+  EXPECT_EQ(token.GetLexeme().data(), source.data() + 7);
+  EXPECT_EQ(token.GetAttribute(), "bar");
+  EXPECT_EQ(token.DebugString(), "kIdentifier:bar");
+
+  const IdentifierToken owning_token("Foo");
+  EXPECT_EQ(owning_token.GetLexeme(), StringPiece(owning_token.GetAttribute()));
+}
+
+TEST(IdentifierToken, GetId) {
+  const std::string source = "foo";
+  const IdentifierToken interned_token(StringPiece(source), 7);
+  EXPECT_EQ(interned_token.GetId(), 7u);
+  EXPECT_EQ(interned_token.GetAttribute(), "foo");
+
+  const IdentifierToken token("foo");
+  EXPECT_TRUE(token.GetId() == StringInterner::kNoId);
+}
+
 TEST(IdentifierToken, DebugString) {
   const IdentifierToken token("Quoz");
   EXPECT_EQ(token.DebugString(), "kIdentifier:Quoz");
@@ -3,9 +3,12 @@
 
 #include "tokens/keyword_token.h"
 
+#include <string>
 #include <utility>
 #include <vector>
 
+#include "util/sink.h"
+
 #include "gtest/gtest.h"
 
 namespace truplc {
@@ -50,5 +53,14 @@ TEST(KeywordToken, DebugString) {
   }
 }
 
+TEST(KeywordTokenTest, AppendDebugString) {
+  std::string out;
+  StringSink sink(&out);
+  KeywordToken(KeywordAttribute::kBegin).AppendDebugString(&sink);
+  sink.Append(" ");
+  KeywordToken(KeywordAttribute::kEnd).AppendDebugString(&sink);
+  EXPECT_EQ(out, "kKeyword:kBegin kKeyword:kEnd");
+}
+
 }  // namespace
 }  // namespace truplc
@@ -3,6 +3,7 @@
 
 #include "tokens/number_token.h"
 
+#include <string>
 #include <vector>
 
 #include "gtest/gtest.h"
@@ -11,7 +12,7 @@ namespace truplc {
 namespace {
 
 TEST(NumberToken, GetTokenType) {
-  const NumberToken token(std::to_string(12345));
+  const NumberToken token(std::to_string(12345), 12345);
   EXPECT_EQ(token.GetTokenType(), TokenType::kNumber);
 }
 
@@ -20,16 +21,38 @@ TEST(NumberToken, GetAttribute) {
   EXPECT_TRUE(default_token.GetAttribute().empty());
 
   const std::string attribute = std::to_string(-2980);
-  const NumberToken specified_token(attribute);
+  const NumberToken specified_token(attribute, -2980);
   EXPECT_EQ(specified_token.GetAttribute(), attribute);
 }
 
+TEST(NumberToken, RefersToLexeme) {
+  const std::string source = "a := 1065;";
+  const NumberToken token(StringPiece(source.data() + 5, 4), 1065);
+  EXPECT_EQ(token.GetLexeme().data(), source.data() + 5);
+  EXPECT_EQ(token.GetAttribute(), "1065");
+  EXPECT_EQ(token.DebugString(), "kNumber:1065");
+}
+
+TEST(NumberToken, GetValue) {
+  EXPECT_EQ(NumberToken().GetValue(), 0);
+  EXPECT_EQ(NumberToken(std::string("1065"), 1065).GetValue(), 1065);
+  EXPECT_EQ(NumberToken(std::string("9223372036854775807"),
+                        9223372036854775807).GetValue(),
+            9223372036854775807);
+
+  // The value is the one given, not parsed again from the digits.
+  EXPECT_EQ(NumberToken(std::string("0012"), 12).GetAttribute(), "0012");
+  const std::string source = "a := 1065;";
+  EXPECT_EQ(NumberToken(StringPiece(source.data() + 5, 4), 1065).GetValue(),
+            1065);
+}
+
 TEST(NumberToken, DebugString) {
   const std::string prefix = "kNumber:";
   const std::vector<int> numbers = {0, 1, 17, -11, 9999, 1065};
   for (const int& number : numbers) {
     const std::string attribute = std::to_string(number);
-    NumberToken token(attribute);
+    NumberToken token(attribute, number);
     EXPECT_EQ(token.DebugString(), prefix + attribute);
   }
 }
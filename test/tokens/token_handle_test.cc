@@ -0,0 +1,53 @@
+// Unit tests for TokenHandle class.
+// Copyright 2016 Hieu Le.
+
+#include "tokens/token_handle.h"
+
+#include <memory>
+#include <utility>
+
+#include "tokens/eof_token.h"
+#include "tokens/number_token.h"
+
+#include "gtest/gtest.h"
+
+namespace truplc {
+namespace {
+
+TEST(TokenHandleTest, Empty) {
+  const TokenHandle handle;
+  EXPECT_FALSE(handle);
+  EXPECT_EQ(handle.get(), nullptr);
+  EXPECT_FALSE(handle.owned());
+}
+
+TEST(TokenHandleTest, Shared) {
+  const EOFToken eof;
+  const TokenHandle handle = TokenHandle::Shared(&eof);
+  ASSERT_TRUE(handle);
+  EXPECT_EQ(handle.get(), &eof);
+  EXPECT_FALSE(handle.owned());
+  EXPECT_EQ(handle->DebugString(), "kEOF:EndOfFile");
+}
+
+TEST(TokenHandleTest, Owned) {
+  TokenHandle handle(std::make_unique<NumberToken>("12", 12));
+  ASSERT_TRUE(handle);
+  EXPECT_TRUE(handle.owned());
+  EXPECT_EQ((*handle).DebugString(), "kNumber:12");
+
+  // Ownership moves along with the token.
+  const Token* const token = handle.get();
+  TokenHandle moved(std::move(handle));
+  EXPECT_FALSE(handle);
+  EXPECT_EQ(moved.get(), token);
+  EXPECT_TRUE(moved.owned());
+
+  const EOFToken eof;
+  moved = TokenHandle::Shared(&eof);
+  EXPECT_EQ(moved.get(), &eof);
+  EXPECT_FALSE(moved.owned());
+}
+
+}  // namespace
+}  // namespace truplc
@@ -0,0 +1,70 @@
+// Unit tests for the registry of shared tokens.
+// Copyright 2016 Hieu Le.
+
+#include "tokens/token_registry.h"
+
+#include "tokens/add_operator_token.h"
+#include "tokens/keyword_token.h"
+#include "tokens/mul_operator_token.h"
+#include "tokens/punctuation_token.h"
+#include "tokens/rel_operator_token.h"
+
+#include "gtest/gtest.h"
+
+namespace truplc {
+namespace {
+
+// Returns the debug string of a shared token, or "null" if there is none.
+std::string FindDebugString(const TokenType type, const int attribute) {
+  const Token* const token = FindSharedToken(type, attribute);
+  return token == nullptr ? "null" : token->DebugString();
+}
+
+TEST(TokenRegistryTest, FindsEveryAttribute) {
+  EXPECT_EQ(FindDebugString(TokenType::kKeyword,
+                            static_cast<int>(KeywordAttribute::kProgram)),
+            "kKeyword:kProgram");
+  EXPECT_EQ(FindDebugString(TokenType::kKeyword,
+                            static_cast<int>(KeywordAttribute::kNot)),
+            "kKeyword:kNot");
+  EXPECT_EQ(FindDebugString(
+                TokenType::kPunctuation,
+                static_cast<int>(PunctuationAttribute::kCloseBracket)),
+            "kPunctuation:kCloseBracket");
+  EXPECT_EQ(FindDebugString(
+                TokenType::kRelOperator,
+                static_cast<int>(RelOperatorAttribute::kLessOrEqual)),
+            "kRelOperator:kLessOrEqual");
+  EXPECT_EQ(FindDebugString(TokenType::kAddOperator,
+                            static_cast<int>(AddOperatorAttribute::kOr)),
+            "kAddOperator:kOr");
+  EXPECT_EQ(FindDebugString(TokenType::kMulOperator,
+                            static_cast<int>(MulOperatorAttribute::kDivide)),
+            "kMulOperator:kDivide");
+  EXPECT_EQ(FindDebugString(TokenType::kEOF, 0), "kEOF:EndOfFile");
+}
+
+TEST(TokenRegistryTest, SharesInstances) {
+  const int kBegin = static_cast<int>(KeywordAttribute::kBegin);
+  EXPECT_EQ(FindSharedToken(TokenType::kKeyword, kBegin),
+            FindSharedToken(TokenType::kKeyword, kBegin));
+  EXPECT_NE(FindSharedToken(TokenType::kKeyword, kBegin),
+            FindSharedToken(TokenType::kKeyword, kBegin + 1));
+}
+
+TEST(TokenRegistryTest, RejectsUnsharedTokens) {
+  EXPECT_EQ(FindSharedToken(TokenType::kIdentifier, 0), nullptr);
+  EXPECT_EQ(FindSharedToken(TokenType::kNumber, 0), nullptr);
+  EXPECT_EQ(FindSharedToken(TokenType::kError, 0), nullptr);
+  EXPECT_EQ(FindSharedToken(TokenType::kKeyword,
+                            static_cast<int>(KeywordAttribute::kUnspecified)),
+            nullptr);
+  EXPECT_EQ(FindSharedToken(
+                TokenType::kPunctuation,
+                static_cast<int>(RelOperatorAttribute::kEqual)),
+            nullptr);
+  EXPECT_EQ(FindSharedToken(TokenType::kAddOperator, -1), nullptr);
+}
+
+}  // namespace
+}  // namespace truplc
@@ -0,0 +1,59 @@
+// Unit tests for TokenStream class.
+// Copyright 2016 Hieu Le.
+
+#include "tokens/token_stream.h"
+
+#include "gtest/gtest.h"
+
+namespace truplc {
+namespace {
+
+TEST(TokenStreamTest, PushBack) {
+  TokenStream stream;
+  EXPECT_TRUE(stream.empty());
+  stream.reserve(3);
+  stream.push_back({TokenType::kIdentifier, 4, 0, 3});
+  stream.push_back({TokenType::kRelOperator, 5, 4, 2});
+  stream.push_back({TokenType::kEOF, 0, 6, 0});
+  ASSERT_EQ(stream.size(), 3u);
+  EXPECT_FALSE(stream.empty());
+
+  EXPECT_EQ(stream.type(0), TokenType::kIdentifier);
+  EXPECT_EQ(stream.attribute(0), 4);
+  EXPECT_EQ(stream.offset(1), 4u);
+  EXPECT_EQ(stream.length(1), 2u);
+  EXPECT_EQ(stream[1], (TokenValue{TokenType::kRelOperator, 5, 4, 2}));
+  EXPECT_EQ(stream[2], (TokenValue{TokenType::kEOF, 0, 6, 0}));
+}
+
+TEST(TokenStreamTest, StoresEveryTokenType) {
+  TokenStream stream;
+  stream.push_back({TokenType::kUnspecified, 0, 0, 0});
+  stream.push_back({TokenType::kEOF, 0, 0, 0});
+  EXPECT_EQ(stream.type(0), TokenType::kUnspecified);
+  EXPECT_EQ(stream.type(1), TokenType::kEOF);
+}
+
+TEST(TokenStreamTest, NumberValues) {
+  TokenStream stream;
+  stream.push_back({TokenType::kNumber, 0, 0, 2}, 12);
+  stream.push_back({TokenType::kAddOperator, 0, 3, 1}, 99);
+  stream.push_back({TokenType::kNumber, 0, 5, 20}, 9223372036854775807);
+  stream.push_back({TokenType::kEOF, 0, 25, 0});
+  ASSERT_EQ(stream.number_count(), 2u);
+  EXPECT_EQ(stream.number(0), 12);
+  EXPECT_EQ(stream.number(1), 9223372036854775807);
+  EXPECT_EQ(stream.attribute(2), 0);
+}
+
+TEST(TokenStreamTest, Clear) {
+  TokenStream stream;
+  stream.push_back({TokenType::kNumber, 0, 0, 2}, 12);
+  stream.clear();
+  EXPECT_TRUE(stream.empty());
+  EXPECT_EQ(stream.size(), 0u);
+  EXPECT_EQ(stream.number_count(), 0u);
+}
+
+}  // namespace
+}  // namespace truplc
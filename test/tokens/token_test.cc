@@ -24,5 +24,12 @@ TEST(Token, DebugString) {
   EXPECT_TRUE(token.DebugString().empty());
 }
 
+TEST(Token, TokenTypeName) {
+  EXPECT_STREQ(TokenTypeName(TokenType::kKeyword), "kKeyword");
+  EXPECT_STREQ(TokenTypeName(TokenType::kIdentifier), "kIdentifier");
+  EXPECT_STREQ(TokenTypeName(TokenType::kEOF), "kEOF");
+  EXPECT_STREQ(TokenTypeName(TokenType::kUnspecified), "kUnspecified");
+}
+
 }  // namespace
 }  // namespace truplc
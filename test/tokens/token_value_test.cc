@@ -0,0 +1,30 @@
+// Unit tests for TokenValue struct.
+// Copyright 2016 Hieu Le.
+
+#include "tokens/token_value.h"
+
+#include <cstring>
+
+#include "gtest/gtest.h"
+
+namespace truplc {
+namespace {
+
+TEST(TokenValueTest, CopiesAsPlainBytes) {
+  const TokenValue value = {TokenType::kNumber, 0, 42, 3};
+  TokenValue copy;
+  std::memcpy(&copy, &value, sizeof(value));
+  EXPECT_EQ(copy, value);
+}
+
+TEST(TokenValueTest, Equality) {
+  const TokenValue value = {TokenType::kIdentifier, 0, 7, 2};
+  EXPECT_EQ(value, (TokenValue{TokenType::kIdentifier, 0, 7, 2}));
+  EXPECT_NE(value, (TokenValue{TokenType::kNumber, 0, 7, 2}));
+  EXPECT_NE(value, (TokenValue{TokenType::kIdentifier, 1, 7, 2}));
+  EXPECT_NE(value, (TokenValue{TokenType::kIdentifier, 0, 8, 2}));
+  EXPECT_NE(value, (TokenValue{TokenType::kIdentifier, 0, 7, 3}));
+}
+
+}  // namespace
+}  // namespace truplc
@@ -0,0 +1,107 @@
+// Unit tests for Arena class.
+// Copyright 2016 Hieu Le.
+
+#include "util/arena.h"
+
+#include <cstdint>
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace truplc {
+namespace {
+
+// Counts its own destructions into a given counter.
+class DestructionCounter {
+ public:
+  explicit DestructionCounter(int* count) : count_(count) {}
+  ~DestructionCounter() { ++*count_; }
+
+ private:
+  int* const count_;
+};
+
+TEST(ArenaTest, AllocateAligns) {
+  Arena arena;
+  for (size_t alignment = 1; alignment <= 64; alignment *= 2) {
+    arena.Allocate(1, 1);
+    const void* p = arena.Allocate(8, alignment);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(p) % alignment, 0u);
+  }
+}
+
+TEST(ArenaTest, AllocationsDoNotOverlap) {
+  Arena arena;
+  char* previous = static_cast<char*>(arena.Allocate(100, 1));
+  for (int i = 0; i < 1000; ++i) {
+    char* const p = static_cast<char*>(arena.Allocate(100, 1));
+    EXPECT_TRUE(p >= previous + 100 || p + 100 <= previous);
+    previous = p;
+  }
+  EXPECT_EQ(arena.bytes_used(), 1001u * 100);
+  EXPECT_GE(arena.bytes_reserved(), arena.bytes_used());
+}
+
+TEST(ArenaTest, LargeAllocationsKeepTheCurrentBlock) {
+  Arena arena;
+  char* const first = static_cast<char*>(arena.Allocate(16, 1));
+  arena.Allocate(1 << 20, 1);
+  char* const second = static_cast<char*>(arena.Allocate(16, 1));
+  EXPECT_EQ(second, first + 16);
+}
+
+TEST(ArenaTest, CopyString) {
+  Arena arena;
+  std::string name = "foo";
+  const StringPiece copy = arena.CopyString(name);
+  name[0] = 'g';
+  EXPECT_EQ(copy.ToString(), "foo");
+  EXPECT_EQ(arena.CopyString(std::string("")).size(), 0u);
+}
+
+TEST(ArenaTest, NewConstructsObjects) {
+  Arena arena;
+  std::string* const str = arena.New<std::string>(3, 'a');
+  const int* const number = arena.New<int>(42);
+  EXPECT_EQ(*str, "aaa");
+  EXPECT_EQ(*number, 42);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(str) % alignof(std::string), 0u);
+}
+
+TEST(ArenaTest, ResetRunsDestructors) {
+  int count = 0;
+  Arena arena;
+  arena.New<DestructionCounter>(&count);
+  arena.New<DestructionCounter>(&count);
+  EXPECT_EQ(count, 0);
+  arena.Reset();
+  EXPECT_EQ(count, 2);
+  EXPECT_EQ(arena.bytes_used(), 0u);
+  EXPECT_EQ(arena.bytes_reserved(), 0u);
+
+  // The arena is usable again after a reset.
+  arena.New<DestructionCounter>(&count);
+  arena.Reset();
+  EXPECT_EQ(count, 3);
+}
+
+TEST(ArenaTest, DestructorRunsDestructors) {
+  int count = 0;
+  {
+    Arena arena;
+    arena.New<DestructionCounter>(&count);
+  }
+  EXPECT_EQ(count, 1);
+}
+
+TEST(ArenaTest, UsableAsMemoryResource) {
+  Arena arena;
+  MemoryResource* const resource = &arena;
+  void* const p = resource->Allocate(32);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(p) % alignof(std::max_align_t), 0u);
+  resource->Deallocate(p, 32);
+  EXPECT_EQ(arena.bytes_used(), 32u);
+}
+
+}  // namespace
+}  // namespace truplc
@@ -0,0 +1,119 @@
+// Unit tests for BufferedWriter class.
+// Copyright 2016 Hieu Le.
+
+#include "util/buffered_writer.h"
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <ostream>
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace truplc {
+namespace {
+
+// Temporary file the writers under test write to.
+class BufferedWriterTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    char name[] = "/tmp/buffered_writer_test.XXXXXX";
+    fd_ = mkstemp(name);
+    filename_ = name;
+  }
+
+  void TearDown() override {
+    close(fd_);
+    unlink(filename_.c_str());
+  }
+
+  // Returns the content written to the file so far.
+  std::string Content() const {
+    std::ifstream file(filename_, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(file),
+                       std::istreambuf_iterator<char>());
+  }
+
+  int fd_;
+  std::string filename_;
+};
+
+TEST_F(BufferedWriterTest, BuffersUntilFlush) {
+  BufferedWriter writer(fd_);
+  writer.Append("kKeyword:");
+  writer.Append(StringPiece("kProgramX", 8));
+  writer.Append('\n');
+  EXPECT_TRUE(Content().empty());
+  EXPECT_TRUE(writer.Flush());
+  EXPECT_EQ(Content(), "kKeyword:kProgram\n");
+}
+
+TEST_F(BufferedWriterTest, AppendsAsSink) {
+  BufferedWriter writer(fd_, 4);
+  Sink* const sink = &writer;
+  sink->Append("kEOF:");
+  sink->Append(StringPiece("EndOfFile"));
+  EXPECT_TRUE(writer.Flush());
+  EXPECT_EQ(Content(), "kEOF:EndOfFile");
+}
+
+TEST_F(BufferedWriterTest, FlushesWhenFull) {
+  {
+    BufferedWriter writer(fd_, 4);
+    writer.Append("abc");
+    writer.Append("de");
+    EXPECT_EQ(Content(), "abc");
+    writer.Append('f');
+    // Blocks larger than the buffer are written directly.
+    writer.Append("0123456789");
+    EXPECT_EQ(Content(), "abcdef0123456789");
+    writer.Append('g');
+  }
+  // The destructor flushes.
+  EXPECT_EQ(Content(), "abcdef0123456789g");
+}
+
+TEST_F(BufferedWriterTest, FlushReportsEarlierFailure) {
+  const int read_only_fd = open(filename_.c_str(), O_RDONLY);
+  ASSERT_GE(read_only_fd, 0);
+  {
+    BufferedWriter writer(read_only_fd, 4);
+    // Written directly, bypassing the buffer, so that the failure happens
+    // while appending.
+    writer.Append("0123456789");
+    EXPECT_FALSE(writer.Flush());
+    EXPECT_FALSE(writer.Flush());
+  }
+  close(read_only_fd);
+}
+
+TEST_F(BufferedWriterTest, AppendDecimal) {
+  BufferedWriter writer(fd_);
+  for (const int64_t value : {int64_t{0}, int64_t{7}, int64_t{-42},
+                              int64_t{1065},
+                              std::numeric_limits<int64_t>::max(),
+                              std::numeric_limits<int64_t>::min()}) {
+    writer.AppendDecimal(value);
+    writer.Append(' ');
+  }
+  writer.Flush();
+  EXPECT_EQ(Content(), "0 7 -42 1065 9223372036854775807 "
+                       "-9223372036854775808 ");
+}
+
+TEST_F(BufferedWriterTest, BacksOstream) {
+  BufferedWriter writer(fd_, 8);
+  std::ostream out(&writer);
+  out << "count: " << 12 << '\n';
+  writer.Append("done");
+  out.flush();
+  EXPECT_EQ(Content(), "count: 12\ndone");
+}
+
+}  // namespace
+}  // namespace truplc
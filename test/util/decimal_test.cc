@@ -0,0 +1,71 @@
+// Unit tests for decimal conversion.
+// Copyright 2016 Hieu Le.
+
+#include "util/decimal.h"
+
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace truplc {
+namespace {
+
+// Returns the value of a digit string, or -1 if it does not convert.
+int64_t Parse(const std::string& digits) {
+  int64_t value = -1;
+  ParseDecimal(digits, &value);
+  return value;
+}
+
+TEST(DecimalTest, ParseDecimal) {
+  EXPECT_EQ(Parse("0"), 0);
+  EXPECT_EQ(Parse("7"), 7);
+  EXPECT_EQ(Parse("1065"), 1065);
+  EXPECT_EQ(Parse("12345678"), 12345678);
+  EXPECT_EQ(Parse("123456789"), 123456789);
+  EXPECT_EQ(Parse("1234567890123456"), 1234567890123456);
+  EXPECT_EQ(Parse("00000000000000000000000042"), 42);
+}
+
+TEST(DecimalTest, ParseDecimalRejectsNonDigits) {
+  EXPECT_EQ(Parse(""), -1);
+  EXPECT_EQ(Parse("12a"), -1);
+  EXPECT_EQ(Parse("-1"), -1);
+  EXPECT_EQ(Parse(" 1"), -1);
+
+  // Every position of an eight-digit block is checked, against characters
+  // just below '0' and just above '9'.
+  for (size_t i = 0; i < 16; ++i) {
+    for (const char c : {'/', ':', '\x80', '\xff'}) {
+      std::string digits(16, '1');
+      digits[i] = c;
+      EXPECT_EQ(Parse(digits), -1) << digits;
+    }
+  }
+}
+
+TEST(DecimalTest, ParseDecimalDetectsOverflow) {
+  const int64_t max = std::numeric_limits<int64_t>::max();
+  EXPECT_EQ(Parse("9223372036854775807"), max);
+  EXPECT_EQ(Parse("09223372036854775807"), max);
+  EXPECT_EQ(Parse("9223372036854775808"), -1);
+  EXPECT_EQ(Parse("9300000000000000000"), -1);
+  EXPECT_EQ(Parse("10000000000000000000"), -1);
+  EXPECT_EQ(Parse("99999999999999999999999999"), -1);
+}
+
+TEST(DecimalTest, ParseDecimalMatchesToString) {
+  std::mt19937_64 random(42);
+  for (int i = 0; i < 10000; ++i) {
+    const int64_t value =
+        static_cast<int64_t>(random() >> (random() % 64)) &
+        std::numeric_limits<int64_t>::max();
+    EXPECT_EQ(Parse(std::to_string(value)), value);
+  }
+}
+
+}  // namespace
+}  // namespace truplc
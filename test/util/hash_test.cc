@@ -0,0 +1,38 @@
+// Unit tests for hashing functions.
+// Copyright 2016 Hieu Le.
+
+#include "util/hash.h"
+
+#include <set>
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace truplc {
+namespace {
+
+TEST(Hash64Test, Deterministic) {
+  const std::string text = "program foo; begin print 1; end;";
+  EXPECT_EQ(Hash64(text.data(), text.size()),
+            Hash64(text.data(), text.size()));
+  EXPECT_EQ(Hash64(nullptr, 0), Hash64("", 0));
+}
+
+TEST(Hash64Test, DependsOnEveryByteAndSeed) {
+  // Cover every tail length and a change in every position.
+  std::string text = "abcdefghijklmnopqrstuvwx";
+  std::set<uint64_t> hashes;
+  for (size_t size = 0; size <= text.size(); ++size) {
+    hashes.insert(Hash64(text.data(), size));
+  }
+  for (size_t i = 0; i < text.size(); ++i) {
+    std::string changed = text;
+    changed[i] = 'z' + 1;
+    hashes.insert(Hash64(changed.data(), changed.size()));
+  }
+  hashes.insert(Hash64(text.data(), text.size(), 1));
+  EXPECT_EQ(hashes.size(), 2 * text.size() + 2);
+}
+
+}  // namespace
+}  // namespace truplc
@@ -0,0 +1,58 @@
+// Unit tests for MappedFile.
+// Copyright 2016 Hieu Le.
+
+#include "util/mapped_file.h"
+
+#include <unistd.h>
+
+#include <fstream>
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace truplc {
+namespace {
+
+// Writes given content to a fresh temporary file and returns its name.
+std::string WriteTemporaryFile(const std::string& content) {
+  char name[] = "/tmp/mapped_file_test.XXXXXX";
+  const int fd = mkstemp(name);
+  close(fd);
+  std::ofstream(name, std::ios::binary) << content;
+  return name;
+}
+
+TEST(MappedFileTest, Open) {
+  const std::string filename = WriteTemporaryFile("program foo;");
+  MappedFile file;
+  ASSERT_TRUE(file.Open(filename));
+  EXPECT_EQ(std::string(file.data(), file.size()), "program foo;");
+  file.Close();
+  EXPECT_EQ(file.data(), nullptr);
+  EXPECT_EQ(file.size(), 0);
+  unlink(filename.c_str());
+}
+
+TEST(MappedFileTest, OpenEmptyFile) {
+  const std::string filename = WriteTemporaryFile("");
+  MappedFile file;
+  ASSERT_TRUE(file.Open(filename));
+  EXPECT_EQ(file.size(), 0);
+  unlink(filename.c_str());
+}
+
+TEST(MappedFileTest, OpenMissingFile) {
+  MappedFile file;
+  EXPECT_FALSE(file.Open("/nonexistent/foo.trupl"));
+}
+
+TEST(IsRegularFileTest, Basic) {
+  const std::string filename = WriteTemporaryFile("");
+  EXPECT_TRUE(IsRegularFile(filename));
+  EXPECT_FALSE(IsRegularFile("/tmp"));
+  EXPECT_FALSE(IsRegularFile("/nonexistent/foo.trupl"));
+  unlink(filename.c_str());
+}
+
+}  // namespace
+}  // namespace truplc
@@ -0,0 +1,34 @@
+// Unit tests for Sink and StringSink classes.
+// Copyright 2016 Hieu Le.
+
+#include "util/sink.h"
+
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace truplc {
+namespace {
+
+TEST(StringSinkTest, Append) {
+  std::string out = "kKeyword";
+  StringSink sink(&out);
+  sink.Append(":");
+  sink.Append(StringPiece("kProgramX", 8));
+  sink.Append("\n", 1);
+  EXPECT_EQ(out, "kKeyword:kProgram\n");
+}
+
+TEST(StringSinkTest, AppendThroughBase) {
+  std::string out;
+  StringSink string_sink(&out);
+  Sink* const sink = &string_sink;
+  for (int i = 0; i < 1000; ++i) {
+    sink->Append("ab");
+  }
+  EXPECT_EQ(out.size(), 2000u);
+  EXPECT_EQ(out.substr(0, 4), "abab");
+}
+
+}  // namespace
+}  // namespace truplc
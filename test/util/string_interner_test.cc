@@ -0,0 +1,76 @@
+// Unit tests for StringInterner class.
+// Copyright 2016 Hieu Le.
+
+#include "util/string_interner.h"
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace truplc {
+namespace {
+
+TEST(StringInternerTest, InternAssignsDenseIds) {
+  StringInterner interner;
+  EXPECT_EQ(interner.Intern(std::string("foo")), 0u);
+  EXPECT_EQ(interner.Intern(std::string("bar")), 1u);
+  EXPECT_EQ(interner.Intern(std::string("foo")), 0u);
+  EXPECT_EQ(interner.Intern(std::string("")), 2u);
+  EXPECT_EQ(interner.Intern(std::string("")), 2u);
+  EXPECT_EQ(interner.size(), 3u);
+}
+
+TEST(StringInternerTest, Find) {
+  StringInterner interner;
+  const StringInterner::Id id = interner.Intern(std::string("foo"));
+  EXPECT_EQ(interner.Find(std::string("foo")), id);
+  EXPECT_EQ(interner.Find(std::string("fo")), StringInterner::kNoId);
+  EXPECT_EQ(interner.Find(std::string("")), StringInterner::kNoId);
+  EXPECT_EQ(interner.size(), 1u);
+}
+
+TEST(StringInternerTest, LookupCopiesTheString) {
+  StringInterner interner;
+  std::string name = "foo";
+  const StringInterner::Id id = interner.Intern(name);
+  name[0] = 'g';
+  EXPECT_EQ(interner.Lookup(id).ToString(), "foo");
+  EXPECT_NE(interner.Lookup(id).data(), name.data());
+  EXPECT_EQ(interner.Lookup(interner.Intern(std::string(""))).ToString(), "");
+}
+
+TEST(StringInternerTest, StringsStayPutAsThePoolGrows) {
+  StringInterner interner;
+  std::vector<std::string> names;
+  std::vector<StringPiece> pieces;
+  for (int i = 0; i < 10000; ++i) {
+    names.push_back("name" + std::to_string(i));
+    pieces.push_back(interner.Lookup(interner.Intern(names.back())));
+  }
+  names.push_back(std::string(100000, 'x'));
+  pieces.push_back(interner.Lookup(interner.Intern(names.back())));
+
+  EXPECT_EQ(interner.size(), names.size());
+  for (size_t i = 0; i < names.size(); ++i) {
+    EXPECT_EQ(interner.Find(names[i]), i);
+    EXPECT_EQ(interner.Lookup(static_cast<StringInterner::Id>(i)).data(),
+              pieces[i].data());
+    EXPECT_EQ(pieces[i].ToString(), names[i]);
+  }
+}
+
+TEST(StringInternerTest, Clear) {
+  StringInterner interner;
+  for (int i = 0; i < 100; ++i) {
+    interner.Intern("name" + std::to_string(i));
+  }
+  interner.Clear();
+  EXPECT_EQ(interner.size(), 0u);
+  EXPECT_EQ(interner.Find(std::string("name0")), StringInterner::kNoId);
+  EXPECT_EQ(interner.Intern(std::string("name1")), 0u);
+  EXPECT_EQ(interner.Lookup(0).ToString(), "name1");
+}
+
+}  // namespace
+}  // namespace truplc
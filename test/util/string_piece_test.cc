@@ -0,0 +1,52 @@
+// Unit tests for StringPiece class.
+// Copyright 2016 Hieu Le.
+
+#include "util/string_piece.h"
+
+#include <sstream>
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace truplc {
+namespace {
+
+TEST(StringPieceTest, Empty) {
+  const StringPiece piece;
+  EXPECT_TRUE(piece.empty());
+  EXPECT_EQ(piece.size(), 0);
+  EXPECT_EQ(piece.ToString(), "");
+  EXPECT_EQ(piece, StringPiece(std::string()));
+}
+
+TEST(StringPieceTest, RefersToCharacters) {
+  const std::string str = "foobar";
+  const StringPiece piece(str.data() + 3, 3);
+  EXPECT_FALSE(piece.empty());
+  EXPECT_EQ(piece.size(), 3);
+  EXPECT_EQ(piece.data(), str.data() + 3);
+  EXPECT_EQ(piece[0], 'b');
+  EXPECT_EQ(std::string(piece.begin(), piece.end()), "bar");
+  EXPECT_EQ(piece.ToString(), "bar");
+
+  const StringPiece whole(str);
+  EXPECT_EQ(whole.data(), str.data());
+  EXPECT_EQ(whole.size(), str.size());
+}
+
+TEST(StringPieceTest, Compare) {
+  const std::string foo = "foo";
+  const std::string bar = "bar";
+  EXPECT_EQ(StringPiece(foo), StringPiece("foobar", 3));
+  EXPECT_NE(StringPiece(foo), StringPiece(bar));
+  EXPECT_NE(StringPiece(foo), StringPiece("fo", 2));
+}
+
+TEST(StringPieceTest, Print) {
+  std::ostringstream out;
+  out << StringPiece("foobar", 3) << StringPiece();
+  EXPECT_EQ(out.str(), "foo");
+}
+
+}  // namespace
+}  // namespace truplc
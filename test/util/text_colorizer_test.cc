@@ -4,13 +4,32 @@
 #include "util/text_colorizer.h"
 
 #include <iostream>
+#include <sstream>
+#include <string>
+
+#include "util/sink.h"
 
 #include "gtest/gtest.h"
 
 namespace truplc {
 namespace {
 
-// TODO(hieule22): Add unit tests.
+TEST(TextColorizerTest, Print) {
+  std::ostringstream os;
+  TextColorizer::Print(os, TextColorizer::kFGRedColorizer, "error");
+  EXPECT_EQ(os.str(), "\033[31merror\033[39m");
+}
+
+TEST(TextColorizerTest, AppendMatchesPrint) {
+  std::ostringstream os;
+  TextColorizer::Print(os, TextColorizer::kFGGreenColorizer, "kEOF\n");
+  std::string output;
+  StringSink sink(&output);
+  TextColorizer::kFGGreenColorizer.AppendColor(&sink);
+  sink.Append("kEOF\n");
+  TextColorizer::AppendReset(&sink);
+  EXPECT_EQ(output, os.str());
+}
 
 }  // namespace
 }  // namespace truplc
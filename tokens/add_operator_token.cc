@@ -3,9 +3,22 @@
 
 #include "tokens/add_operator_token.h"
 
-#include <cassert>
-
 namespace truplc {
+namespace {
+
+// Names of the adding operator attributes from kAdd on, as used in debug
+// strings.
+constexpr const char* kAttributeNames[] = {
+    "kAdd",
+    "kSubtract",
+    "kOr",
+};
+
+// Number of entries in kAttributeNames.
+constexpr unsigned kNumAttributeNames =
+    sizeof(kAttributeNames) / sizeof(kAttributeNames[0]);
+
+}  // namespace
 
 AddOperatorToken::AddOperatorToken(const AddOperatorAttribute attribute)
     : Token(TokenType::kAddOperator), attribute_(attribute) {}
@@ -16,26 +29,12 @@ AddOperatorAttribute AddOperatorToken::GetAttribute() const {
   return attribute_;
 }
 
-std::string AddOperatorToken::DebugString() const {
-  const std::string prefix = "kAddOperator:";
-
-  switch (attribute_) {
-    case AddOperatorAttribute::kAdd: {
-      return prefix + "kAdd";
-    }
-    case AddOperatorAttribute::kSubtract: {
-      return prefix + "kSubtract";
-    }
-    case AddOperatorAttribute::kOr: {
-      return prefix + "kOr";
-    }
-    case AddOperatorAttribute::kUnspecified: {
-      return prefix + "kUnspecified";
-    }
-    default: {
-      assert(false);
-    }
-  }
+void AddOperatorToken::AppendDebugString(Sink* const sink) const {
+  const unsigned index = static_cast<unsigned>(attribute_) -
+                         static_cast<unsigned>(AddOperatorAttribute::kAdd);
+  sink->Append("kAddOperator:");
+  sink->Append(index < kNumAttributeNames ? kAttributeNames[index]
+                                          : "kUnspecified");
 }
 
 }  // namespace truplc
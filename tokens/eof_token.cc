@@ -9,8 +9,8 @@ EOFToken::EOFToken() : Token(TokenType::kEOF) {}
 
 EOFToken::~EOFToken() {}
 
-std::string EOFToken::DebugString() const {
-  return "kEOF:EndOfFile";
+void EOFToken::AppendDebugString(Sink* const sink) const {
+  sink->Append("kEOF:EndOfFile");
 }
 
 }  // namespace truplc
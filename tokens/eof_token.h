@@ -4,9 +4,8 @@
 #ifndef TRUPLC_TOKENS_EOF_TOKEN_H__
 #define TRUPLC_TOKENS_EOF_TOKEN_H__
 
-#include <string>
-
 #include "tokens/token.h"
+#include "util/sink.h"
 
 namespace truplc {
 
@@ -18,7 +17,8 @@ class EOFToken : public Token {
 
   ~EOFToken() override;
 
-  std::string DebugString() const override;
+  // Appends "kEOF:EndOfFile" to a sink.
+  void AppendDebugString(Sink* sink) const override;
 };
 
 }  // namespace truplc
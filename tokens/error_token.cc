@@ -0,0 +1,22 @@
+// Implementation of ErrorToken class.
+// Copyright 2016 Hieu Le.
+
+#include "tokens/error_token.h"
+
+namespace truplc {
+
+ErrorToken::ErrorToken(const std::string& lexeme)
+    : Token(TokenType::kError), lexeme_(lexeme) {}
+
+ErrorToken::~ErrorToken() {}
+
+const std::string& ErrorToken::GetLexeme() const {
+  return lexeme_;
+}
+
+void ErrorToken::AppendDebugString(Sink* const sink) const {
+  sink->Append("kError:");
+  sink->Append(lexeme_);
+}
+
+}  // namespace truplc
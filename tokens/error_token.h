@@ -0,0 +1,38 @@
+// Token class for lexical errors from TruPL. Only scanned when error recovery
+// is enabled; the lexeme is the malformed input skipped by the scanner.
+// Copyright 2016 Hieu Le.
+
+#ifndef TRUPLC_TOKENS_ERROR_TOKEN_H__
+#define TRUPLC_TOKENS_ERROR_TOKEN_H__
+
+#include <string>
+
+#include "tokens/token.h"
+#include "util/sink.h"
+
+namespace truplc {
+
+class ErrorToken : public Token {
+ public:
+  // Constructs an error token from the skipped input. If no lexeme is
+  // provided, defaults to an empty string.
+  explicit ErrorToken(const std::string& lexeme = "");
+
+  ~ErrorToken() override;
+
+  // Returns the input skipped by the scanner.
+  const std::string& GetLexeme() const;
+
+  // Appends a debug string consisting of the token type and its lexeme to a
+  // sink. Output will be of the form "kError":<Lexeme>.
+  void AppendDebugString(Sink* sink) const override;
+
+ private:
+  // The input skipped by the scanner, which may hold characters outside the
+  // TruPL alphabet.
+  const std::string lexeme_;
+};
+
+}  // namespace truplc
+
+#endif  // TRUPLC_TOKENS_ERROR_TOKEN_H__
@@ -6,16 +6,39 @@
 namespace truplc {
 
 IdentifierToken::IdentifierToken(const std::string& attribute)
-    : Token(TokenType::kIdentifier), attribute_(attribute) {}
+    : Token(TokenType::kIdentifier),
+      attribute_(attribute),
+      id_(StringInterner::kNoId) {}
+
+IdentifierToken::IdentifierToken(const StringPiece lexeme)
+    : Token(TokenType::kIdentifier),
+      lexeme_(lexeme),
+      id_(StringInterner::kNoId) {}
+
+IdentifierToken::IdentifierToken(const StringPiece lexeme,
+                                 const StringInterner::Id id)
+    : Token(TokenType::kIdentifier), lexeme_(lexeme), id_(id) {}
 
 IdentifierToken::~IdentifierToken() {}
 
 const std::string& IdentifierToken::GetAttribute() const {
+  if (lexeme_.data() != nullptr && attribute_.size() != lexeme_.size()) {
+    attribute_ = lexeme_.ToString();
+  }
   return attribute_;
 }
 
-std::string IdentifierToken::DebugString() const {
-  return "kIdentifier:" + attribute_;
+StringPiece IdentifierToken::GetLexeme() const {
+  return lexeme_.data() != nullptr ? lexeme_ : StringPiece(attribute_);
+}
+
+StringInterner::Id IdentifierToken::GetId() const {
+  return id_;
+}
+
+void IdentifierToken::AppendDebugString(Sink* const sink) const {
+  sink->Append("kIdentifier:");
+  sink->Append(GetLexeme());
 }
 
 }  // namespace truplc
@@ -7,6 +7,9 @@
 #include <string>
 
 #include "tokens/token.h"
+#include "util/sink.h"
+#include "util/string_interner.h"
+#include "util/string_piece.h"
 
 namespace truplc {
 
@@ -17,18 +20,42 @@ class IdentifierToken : public Token {
   // defaults to empty string.
   explicit IdentifierToken(const std::string& attribute = "");
 
+  // Constructs an identifier token that refers to its lexeme in place instead
+  // of copying it. The referenced characters must outlive the token.
+  explicit IdentifierToken(StringPiece lexeme);
+
+  // Constructs an identifier token that refers to its lexeme in place and
+  // carries the id under which the lexeme is interned.
+  IdentifierToken(StringPiece lexeme, StringInterner::Id id);
+
   ~IdentifierToken() override;
 
-  // Returns the string literal representing this identifier token.
+  // Returns the string literal representing this identifier token. A token
+  // that refers to its lexeme copies it into a string on the first call.
   const std::string& GetAttribute() const;
 
-  // Returns a debug string consisting of the token type and its' attribute.
-  // Output will be of the form "kIdentifier":<StringLiteral>.
-  std::string DebugString() const override;
+  // Returns the characters of this identifier token without copying them.
+  StringPiece GetLexeme() const;
+
+  // Returns the interned id of this identifier, or StringInterner::kNoId if
+  // the token was not built from an interned lexeme.
+  StringInterner::Id GetId() const;
+
+  // Appends a debug string consisting of the token type and its attribute to a
+  // sink. Output will be of the form "kIdentifier":<StringLiteral>.
+  void AppendDebugString(Sink* sink) const override;
 
  private:
-  // The string literal representing this identifier's name.
-  const std::string attribute_;
+  // The characters of this token when it refers to its lexeme in place. Null
+  // data means the token owns its attribute_.
+  const StringPiece lexeme_;
+
+  // The string literal representing this identifier's name. Materialized
+  // lazily from lexeme_ when the token does not own it.
+  mutable std::string attribute_;
+
+  // Interned id of this identifier's name.
+  const StringInterner::Id id_;
 };
 
 }  // namespace truplc
@@ -3,9 +3,32 @@
 
 #include "tokens/keyword_token.h"
 
-#include <cassert>
-
 namespace truplc {
+namespace {
+
+// Names of the keyword attributes from kProgram on, as used in debug
+// strings.
+constexpr const char* kAttributeNames[] = {
+    "kProgram",
+    "kProcedure",
+    "kInt",
+    "kBool",
+    "kBegin",
+    "kEnd",
+    "kIf",
+    "kThen",
+    "kElse",
+    "kWhile",
+    "kLoop",
+    "kPrint",
+    "kNot",
+};
+
+// Number of entries in kAttributeNames.
+constexpr unsigned kNumAttributeNames =
+    sizeof(kAttributeNames) / sizeof(kAttributeNames[0]);
+
+}  // namespace
 
 KeywordToken::KeywordToken(const KeywordAttribute attribute)
     : Token(TokenType::kKeyword), attribute_(attribute) {}
@@ -16,56 +39,12 @@ KeywordAttribute KeywordToken::GetAttribute() const {
   return attribute_;
 }
 
-std::string KeywordToken::DebugString() const {
-  const std::string prefix = "kKeyword:";
-
-  switch (attribute_) {
-    case KeywordAttribute::kProgram: {
-      return prefix + "kProgram";
-    }
-    case KeywordAttribute::kProcedure: {
-      return prefix + "kProcedure";
-    }
-    case KeywordAttribute::kInt: {
-      return prefix + "kInt";
-    }
-    case KeywordAttribute::kBool: {
-      return prefix + "kBool";
-    }
-    case KeywordAttribute::kBegin: {
-      return prefix + "kBegin";
-    }
-    case KeywordAttribute::kEnd: {
-      return prefix + "kEnd";
-    }
-    case KeywordAttribute::kIf: {
-      return prefix + "kIf";
-    }
-    case KeywordAttribute::kThen: {
-      return prefix + "kThen";
-    }
-    case KeywordAttribute::kElse: {
-      return prefix + "kElse";
-    }
-    case KeywordAttribute::kWhile: {
-      return prefix + "kWhile";
-    }
-    case KeywordAttribute::kLoop: {
-      return prefix + "kLoop";
-    }
-    case KeywordAttribute::kPrint: {
-      return prefix + "kPrint";
-    }
-    case KeywordAttribute::kNot: {
-      return prefix + "kNot";
-    }
-    case KeywordAttribute::kUnspecified: {
-      return prefix + "kUnspecified";
-    }
-    default: {
-      assert(false);
-    }
-  }
+void KeywordToken::AppendDebugString(Sink* const sink) const {
+  const unsigned index = static_cast<unsigned>(attribute_) -
+                         static_cast<unsigned>(KeywordAttribute::kProgram);
+  sink->Append("kKeyword:");
+  sink->Append(index < kNumAttributeNames ? kAttributeNames[index]
+                                          : "kUnspecified");
 }
 
 }  // namespace truplc
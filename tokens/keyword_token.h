@@ -4,9 +4,8 @@
 #ifndef TRUPLC_TOKENS_KEYWORD_TOKEN_H__
 #define TRUPLC_TOKENS_KEYWORD_TOKEN_H__
 
-#include <string>
-
 #include "tokens/token.h"
+#include "util/sink.h"
 
 namespace truplc {
 
@@ -40,9 +39,9 @@ class KeywordToken : public Token {
   // Returns the attribute of this keyword token.
   KeywordAttribute GetAttribute() const;
 
-  // Returns a debug string consisting of the token type and its' attribute.
-  // Output will be of the form "kKeyword":<KeywordAttribute>.
-  std::string DebugString() const override;
+  // Appends a debug string consisting of the token type and its attribute
+  // to a sink. Output will be of the form "kKeyword":<KeywordAttribute>.
+  void AppendDebugString(Sink* sink) const override;
 
  private:
   // The attribute of this keyword token.
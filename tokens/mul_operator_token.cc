@@ -3,9 +3,22 @@
 
 #include "tokens/mul_operator_token.h"
 
-#include <cassert>
-
 namespace truplc {
+namespace {
+
+// Names of the multiplying operator attributes from kMultiply on, as used in debug
+// strings.
+constexpr const char* kAttributeNames[] = {
+    "kMultiply",
+    "kDivide",
+    "kAnd",
+};
+
+// Number of entries in kAttributeNames.
+constexpr unsigned kNumAttributeNames =
+    sizeof(kAttributeNames) / sizeof(kAttributeNames[0]);
+
+}  // namespace
 
 MulOperatorToken::MulOperatorToken(const MulOperatorAttribute attribute)
     : Token(TokenType::kMulOperator), attribute_(attribute) {}
@@ -16,26 +29,12 @@ MulOperatorAttribute MulOperatorToken::GetAttribute() const {
   return attribute_;
 }
 
-std::string MulOperatorToken::DebugString() const {
-  const std::string prefix = "kMulOperator:";
-
-  switch (attribute_) {
-    case MulOperatorAttribute::kMultiply: {
-      return prefix + "kMultiply";
-    }
-    case MulOperatorAttribute::kDivide: {
-      return prefix + "kDivide";
-    }
-    case MulOperatorAttribute::kAnd: {
-      return prefix + "kAnd";
-    }
-    case MulOperatorAttribute::kUnspecified: {
-      return prefix + "kUnspecified";
-    }
-    default: {
-      assert(false);
-    }
-  }
+void MulOperatorToken::AppendDebugString(Sink* const sink) const {
+  const unsigned index = static_cast<unsigned>(attribute_) -
+                         static_cast<unsigned>(MulOperatorAttribute::kMultiply);
+  sink->Append("kMulOperator:");
+  sink->Append(index < kNumAttributeNames ? kAttributeNames[index]
+                                          : "kUnspecified");
 }
 
 }  // namespace truplc
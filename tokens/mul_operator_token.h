@@ -4,9 +4,8 @@
 #ifndef TRUPLC_TOKENS_MUL_OPERATOR_TOKEN_H__
 #define TRUPLC_TOKENS_MUL_OPERATOR_TOKEN_H__
 
-#include <string>
-
 #include "tokens/token.h"
+#include "util/sink.h"
 
 namespace truplc {
 
@@ -30,9 +29,9 @@ class MulOperatorToken : public Token {
   // Returns the attribute of this multiplicative operator token.
   MulOperatorAttribute GetAttribute() const;
 
-  // Returns a debug string consisting of the token type and its' attribute.
-  // Output will be in the form "kMulOperator":<MulOperatorAttribute>.
-  std::string DebugString() const override;
+  // Appends a debug string consisting of the token type and its attribute
+  // to a sink. Output will be of the form "kMulOperator":<MulOperatorAttribute>.
+  void AppendDebugString(Sink* sink) const override;
 
  private:
   // The attribute of this multiplicative operator token.
@@ -5,17 +5,30 @@
 
 namespace truplc {
 
-NumberToken::NumberToken(const std::string& attribute)
-    : Token(TokenType::kNumber), attribute_(attribute) {}
+NumberToken::NumberToken() : Token(TokenType::kNumber), value_(0) {}
+
+NumberToken::NumberToken(const std::string& attribute, const int64_t value)
+    : Token(TokenType::kNumber), attribute_(attribute), value_(value) {}
+
+NumberToken::NumberToken(const StringPiece lexeme, const int64_t value)
+    : Token(TokenType::kNumber), lexeme_(lexeme), value_(value) {}
 
 NumberToken::~NumberToken() {}
 
 const std::string& NumberToken::GetAttribute() const {
+  if (lexeme_.data() != nullptr && attribute_.size() != lexeme_.size()) {
+    attribute_ = lexeme_.ToString();
+  }
   return attribute_;
 }
 
-std::string NumberToken::DebugString() const {
-  return "kNumber:" + attribute_;
+StringPiece NumberToken::GetLexeme() const {
+  return lexeme_.data() != nullptr ? lexeme_ : StringPiece(attribute_);
+}
+
+void NumberToken::AppendDebugString(Sink* const sink) const {
+  sink->Append("kNumber:");
+  sink->Append(GetLexeme());
 }
 
 }  // namespace truplc
@@ -4,31 +4,58 @@
 #ifndef TRUPLC_TOKENS_NUMBER_TOKEN_H__
 #define TRUPLC_TOKENS_NUMBER_TOKEN_H__
 
+#include <cstdint>
 #include <string>
 
 #include "tokens/token.h"
+#include "util/sink.h"
+#include "util/string_piece.h"
 
 namespace truplc {
 
 class NumberToken : public Token {
  public:
+  // Constructs a number token with an empty attribute and the value 0.
+  NumberToken();
+
   // Constructs a number token from specified attribute which is the string
-  // literal representing that number. If no attribute is provided, defaults
-  // to an empty string.
-  explicit NumberToken(const std::string& attribute = "");
+  // literal representing that number, and from the value of that literal as
+  // converted by the scanner.
+  NumberToken(const std::string& attribute, int64_t value);
+
+  // Constructs a number token that refers to its lexeme in place instead of
+  // copying it. The referenced characters must outlive the token.
+  NumberToken(StringPiece lexeme, int64_t value);
 
   ~NumberToken() override;
 
-  // Returns the string literal representing this number token.
+  // Returns the string literal representing this number token. A token that
+  // refers to its lexeme copies it into a string on the first call.
   const std::string& GetAttribute() const;
 
-  // Returns a debug string consisting of the token type and its' attribute.
-  // Output will be of the form "kNumber":<StringLiteral>.
-  std::string DebugString() const override;
+  // Returns the characters of this number token without copying them.
+  StringPiece GetLexeme() const;
+
+  // Returns the value of this number. The scanner converts each literal once
+  // and reports those out of range as lexical errors, so the value is never
+  // parsed again here.
+  int64_t GetValue() const { return value_; }
+
+  // Appends a debug string consisting of the token type and its attribute to a
+  // sink. Output will be of the form "kNumber":<StringLiteral>.
+  void AppendDebugString(Sink* sink) const override;
 
  private:
-  // The string literal representing this number's value.
-  const std::string attribute_;
+  // The characters of this token when it refers to its lexeme in place. Null
+  // data means the token owns its attribute_.
+  const StringPiece lexeme_;
+
+  // The string literal representing this number's value. Materialized lazily
+  // from lexeme_ when the token does not own it.
+  mutable std::string attribute_;
+
+  // The value of this number.
+  const int64_t value_;
 };
 
 }  // namespace truplc
@@ -3,9 +3,25 @@
 
 #include "tokens/punctuation_token.h"
 
-#include <cassert>
-
 namespace truplc {
+namespace {
+
+// Names of the punctuation attributes from kSemicolon on, as used in debug
+// strings.
+constexpr const char* kAttributeNames[] = {
+    "kSemicolon",
+    "kColon",
+    "kComma",
+    "kAssignment",
+    "kOpenBracket",
+    "kCloseBracket",
+};
+
+// Number of entries in kAttributeNames.
+constexpr unsigned kNumAttributeNames =
+    sizeof(kAttributeNames) / sizeof(kAttributeNames[0]);
+
+}  // namespace
 
 PunctuationToken::PunctuationToken(const PunctuationAttribute attribute)
     : Token(TokenType::kPunctuation), attribute_(attribute) {}
@@ -16,35 +32,12 @@ PunctuationAttribute PunctuationToken::GetAttribute() const {
   return attribute_;
 }
 
-std::string PunctuationToken::DebugString() const {
-  const std::string prefix = "kPunctuation:";
-
-  switch (attribute_) {
-    case PunctuationAttribute::kSemicolon: {
-      return prefix + "kSemicolon";
-    }
-    case PunctuationAttribute::kColon: {
-      return prefix + "kColon";
-    }
-    case PunctuationAttribute::kComma: {
-      return prefix + "kComma";
-    }
-    case PunctuationAttribute::kAssignment: {
-      return prefix + "kAssignment";
-    }
-    case PunctuationAttribute::kOpenBracket: {
-      return prefix + "kOpenBracket";
-    }
-    case PunctuationAttribute::kCloseBracket: {
-      return prefix + "kCloseBracket";
-    }
-    case PunctuationAttribute::kUnspecified: {
-      return prefix + "kUnspecified";
-    }
-    default: {
-      assert(false);
-    }
-  }
+void PunctuationToken::AppendDebugString(Sink* const sink) const {
+  const unsigned index = static_cast<unsigned>(attribute_) -
+                         static_cast<unsigned>(PunctuationAttribute::kSemicolon);
+  sink->Append("kPunctuation:");
+  sink->Append(index < kNumAttributeNames ? kAttributeNames[index]
+                                          : "kUnspecified");
 }
 
 }  // namespace truplc
@@ -4,9 +4,8 @@
 #ifndef TRUPLC_TOKENS_PUNCTUATION_TOKEN_H__
 #define TRUPLC_TOKENS_PUNCTUATION_TOKEN_H__
 
-#include <string>
-
 #include "tokens/token.h"
+#include "util/sink.h"
 
 namespace truplc {
 
@@ -33,9 +32,9 @@ class PunctuationToken : public Token {
   // Returns the attribute of this punctuation token.
   PunctuationAttribute GetAttribute() const;
 
-  // Returns a debug string consisting of the token type and its' attribute.
-  // Output will be in the form "kPunctuation":<PunctuationAttribute>.
-  std::string DebugString() const override;
+  // Appends a debug string consisting of the token type and its attribute
+  // to a sink. Output will be of the form "kPunctuation":<PunctuationAttribute>.
+  void AppendDebugString(Sink* sink) const override;
 
  private:
   // The attribute of this punctuation token.
@@ -3,9 +3,25 @@
 
 #include "tokens/rel_operator_token.h"
 
-#include <cassert>
-
 namespace truplc {
+namespace {
+
+// Names of the relational operator attributes from kEqual on, as used in debug
+// strings.
+constexpr const char* kAttributeNames[] = {
+    "kEqual",
+    "kNotEqual",
+    "kGreaterThan",
+    "kGreaterOrEqual",
+    "kLessThan",
+    "kLessOrEqual",
+};
+
+// Number of entries in kAttributeNames.
+constexpr unsigned kNumAttributeNames =
+    sizeof(kAttributeNames) / sizeof(kAttributeNames[0]);
+
+}  // namespace
 
 RelOperatorToken::RelOperatorToken(const RelOperatorAttribute attribute)
     : Token(TokenType::kRelOperator), attribute_(attribute) {}
@@ -16,35 +32,12 @@ RelOperatorAttribute RelOperatorToken::GetAttribute() const {
   return attribute_;
 }
 
-std::string RelOperatorToken::DebugString() const {
-  const std::string prefix = "kRelOperator:";
-
-  switch (attribute_) {
-    case RelOperatorAttribute::kEqual: {
-      return prefix + "kEqual";
-    }
-    case RelOperatorAttribute::kNotEqual: {
-      return prefix + "kNotEqual";
-    }
-    case RelOperatorAttribute::kGreaterThan: {
-      return prefix + "kGreaterThan";
-    }
-    case RelOperatorAttribute::kGreaterOrEqual: {
-      return prefix + "kGreaterOrEqual";
-    }
-    case RelOperatorAttribute::kLessThan: {
-      return prefix + "kLessThan";
-    }
-    case RelOperatorAttribute::kLessOrEqual: {
-      return prefix + "kLessOrEqual";
-    }
-    case RelOperatorAttribute::kUnspecified: {
-      return prefix + "kUnspecified";
-    }
-    default: {
-      assert(false);
-    }
-  }
+void RelOperatorToken::AppendDebugString(Sink* const sink) const {
+  const unsigned index = static_cast<unsigned>(attribute_) -
+                         static_cast<unsigned>(RelOperatorAttribute::kEqual);
+  sink->Append("kRelOperator:");
+  sink->Append(index < kNumAttributeNames ? kAttributeNames[index]
+                                          : "kUnspecified");
 }
 
 }  // namespace truplc
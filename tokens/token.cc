@@ -5,6 +5,31 @@
 
 namespace truplc {
 
+const char* TokenTypeName(const TokenType type) {
+  switch (type) {
+    case TokenType::kKeyword:
+      return "kKeyword";
+    case TokenType::kPunctuation:
+      return "kPunctuation";
+    case TokenType::kRelOperator:
+      return "kRelOperator";
+    case TokenType::kAddOperator:
+      return "kAddOperator";
+    case TokenType::kMulOperator:
+      return "kMulOperator";
+    case TokenType::kIdentifier:
+      return "kIdentifier";
+    case TokenType::kNumber:
+      return "kNumber";
+    case TokenType::kEOF:
+      return "kEOF";
+    case TokenType::kError:
+      return "kError";
+    default:
+      return "kUnspecified";
+  }
+}
+
 Token::Token(const TokenType token_type) : type_(token_type) {}
 
 Token::~Token() {}
@@ -13,8 +38,13 @@ TokenType Token::GetTokenType() const {
   return type_;
 }
 
+void Token::AppendDebugString(Sink* const) const {}
+
 std::string Token::DebugString() const {
-  return "";
+  std::string str;
+  StringSink sink(&str);
+  AppendDebugString(&sink);
+  return str;
 }
 
 }  // namespace truplc
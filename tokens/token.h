@@ -6,6 +6,8 @@
 
 #include <string>
 
+#include "util/sink.h"
+
 namespace truplc {
 
 // Types of tokens from TruPL.
@@ -18,9 +20,13 @@ enum class TokenType : int {
     kIdentifier  = 5,
     kNumber      = 6,
     kEOF         = 7,
+    kError       = 8,
     kUnspecified = 99,
 };
 
+// Returns the name of a token type as used in debug strings, e.g. "kKeyword".
+const char* TokenTypeName(TokenType type);
+
 class Token {
  public:
   // Constructs a token from given token type.
@@ -33,9 +39,13 @@ class Token {
   // Returns the type of this token.
   TokenType GetTokenType() const;
 
-  // Returns a debug string consisting of the token type and its' attribute.
-  // Output should be of the form TOKEN_TYPE:Attribute.
-  virtual std::string DebugString() const;
+  // Appends a debug string consisting of the token type and its attribute to
+  // a sink, without allocating. Output should be of the form
+  // TOKEN_TYPE:Attribute. The base token appends nothing.
+  virtual void AppendDebugString(Sink* sink) const;
+
+  // Returns the debug string appended by AppendDebugString().
+  std::string DebugString() const;
 
  private:
   // The type of this token.
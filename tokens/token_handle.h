@@ -0,0 +1,89 @@
+// Handle to a token object returned by the scanner. Keyword, punctuation,
+// operator and EOF tokens are fully described by their attribute and are
+// shared instances, which the handle only points to; identifier, number and
+// error tokens carry their lexeme and are owned by the handle, unless they are
+// allocated in an arena.
+// Copyright 2016 Hieu Le.
+
+#ifndef TRUPLC_TOKENS_TOKEN_HANDLE_H__
+#define TRUPLC_TOKENS_TOKEN_HANDLE_H__
+
+#include <memory>
+
+#include "tokens/token.h"
+
+namespace truplc {
+
+class TokenHandle {
+ public:
+  // Constructs a handle to no token.
+  TokenHandle() : token_(nullptr), owned_(false) {}
+
+  // Constructs a handle owning a given token.
+  explicit TokenHandle(std::unique_ptr<Token> token)
+      : token_(token.release()), owned_(true) {}
+
+  // Returns a handle to a token it does not own, such as a shared instance or
+  // a token allocated in an arena. The token must outlive the handle.
+  static TokenHandle Shared(const Token* token) {
+    TokenHandle handle;
+    handle.token_ = token;
+    return handle;
+  }
+
+  TokenHandle(TokenHandle&& other)
+      : token_(other.token_), owned_(other.owned_) {
+    other.token_ = nullptr;
+    other.owned_ = false;
+  }
+
+  TokenHandle& operator=(TokenHandle&& other) {
+    if (this != &other) {
+      Reset();
+      token_ = other.token_;
+      owned_ = other.owned_;
+      other.token_ = nullptr;
+      other.owned_ = false;
+    }
+    return *this;
+  }
+
+  TokenHandle(const TokenHandle&) = delete;
+  TokenHandle& operator=(const TokenHandle&) = delete;
+
+  ~TokenHandle() { Reset(); }
+
+  // Returns the token, or null if there is none.
+  const Token* get() const { return token_; }
+
+  // Accesses the token, which must exist.
+  const Token& operator*() const { return *token_; }
+  const Token* operator->() const { return token_; }
+
+  // Checks if the handle refers to a token.
+  explicit operator bool() const { return token_ != nullptr; }
+
+  // Checks if the token is owned by the handle rather than shared or
+  // allocated in an arena.
+  bool owned() const { return owned_; }
+
+ private:
+  // Deletes the token if it is owned, and then refers to no token.
+  void Reset() {
+    if (owned_) {
+      delete token_;
+    }
+    token_ = nullptr;
+    owned_ = false;
+  }
+
+  // The token, or null.
+  const Token* token_;
+
+  // Whether token_ is owned by the handle.
+  bool owned_;
+};
+
+}  // namespace truplc
+
+#endif  // TRUPLC_TOKENS_TOKEN_HANDLE_H__
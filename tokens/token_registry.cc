@@ -0,0 +1,94 @@
+// Implementation for the registry of shared tokens.
+// Copyright 2016 Hieu Le.
+
+#include "tokens/token_registry.h"
+
+#include <memory>
+#include <vector>
+
+#include "tokens/add_operator_token.h"
+#include "tokens/eof_token.h"
+#include "tokens/keyword_token.h"
+#include "tokens/mul_operator_token.h"
+#include "tokens/punctuation_token.h"
+#include "tokens/rel_operator_token.h"
+
+namespace truplc {
+namespace {
+
+// Shared tokens of one type, whose attributes are consecutive.
+class SharedTokenTable {
+ public:
+  // Builds a token of type T for each attribute in [first, last].
+  template <typename T, typename Attribute>
+  static SharedTokenTable Build(const Attribute first, const Attribute last) {
+    SharedTokenTable table(static_cast<int>(first));
+    for (int i = static_cast<int>(first); i <= static_cast<int>(last); ++i) {
+      table.tokens_.push_back(std::make_unique<T>(static_cast<Attribute>(i)));
+    }
+    return table;
+  }
+
+  // Returns the token with a given attribute, or null if there is none.
+  const Token* Find(const int attribute) const {
+    const unsigned index = static_cast<unsigned>(attribute - first_);
+    return index < tokens_.size() ? tokens_[index].get() : nullptr;
+  }
+
+ private:
+  explicit SharedTokenTable(const int first) : first_(first) {}
+
+  // Attribute of the first token.
+  int first_;
+
+  // The tokens, in attribute order.
+  std::vector<std::unique_ptr<const Token>> tokens_;
+};
+
+// All shared tokens.
+struct SharedTokens {
+  SharedTokens()
+      : keywords(SharedTokenTable::Build<KeywordToken>(
+            KeywordAttribute::kProgram, KeywordAttribute::kNot)),
+        punctuation(SharedTokenTable::Build<PunctuationToken>(
+            PunctuationAttribute::kSemicolon,
+            PunctuationAttribute::kCloseBracket)),
+        rel_operators(SharedTokenTable::Build<RelOperatorToken>(
+            RelOperatorAttribute::kEqual, RelOperatorAttribute::kLessOrEqual)),
+        add_operators(SharedTokenTable::Build<AddOperatorToken>(
+            AddOperatorAttribute::kAdd, AddOperatorAttribute::kOr)),
+        mul_operators(SharedTokenTable::Build<MulOperatorToken>(
+            MulOperatorAttribute::kMultiply, MulOperatorAttribute::kAnd)) {}
+
+  const SharedTokenTable keywords;
+  const SharedTokenTable punctuation;
+  const SharedTokenTable rel_operators;
+  const SharedTokenTable add_operators;
+  const SharedTokenTable mul_operators;
+  const EOFToken eof;
+};
+
+}  // namespace
+
+const Token* FindSharedToken(const TokenType type, const int attribute) {
+  // Never destroyed, so that tokens stay valid during static destruction.
+  static const SharedTokens* const shared = new SharedTokens();
+  switch (type) {
+    case TokenType::kKeyword:
+      return shared->keywords.Find(attribute);
+    case TokenType::kPunctuation:
+      return shared->punctuation.Find(attribute);
+    case TokenType::kRelOperator:
+      return shared->rel_operators.Find(attribute);
+    case TokenType::kAddOperator:
+      return shared->add_operators.Find(attribute);
+    case TokenType::kMulOperator:
+      return shared->mul_operators.Find(attribute);
+    case TokenType::kEOF:
+      return &shared->eof;
+    default:
+      return nullptr;
+  }
+}
+
+}  // namespace truplc
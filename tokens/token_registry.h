@@ -0,0 +1,22 @@
+// Registry of the shared instances of tokens that are fully described by
+// their attribute. The scanner hands out these instances instead of
+// allocating a token per occurrence.
+// Copyright 2016 Hieu Le.
+
+#ifndef TRUPLC_TOKENS_TOKEN_REGISTRY_H__
+#define TRUPLC_TOKENS_TOKEN_REGISTRY_H__
+
+#include "tokens/token.h"
+
+namespace truplc {
+
+// Returns the shared keyword, punctuation, operator or EOF token with a given
+// type and attribute, or null if tokens of that type carry a lexeme or the
+// attribute is not one of the type. The attribute of an EOF token is
+// ignored. Shared tokens are built on first use, live for the whole program
+// and must not be deleted.
+const Token* FindSharedToken(TokenType type, int attribute);
+
+}  // namespace truplc
+
+#endif  // TRUPLC_TOKENS_TOKEN_REGISTRY_H__
@@ -0,0 +1,99 @@
+// Sequence of scanned tokens stored as parallel arrays, one per field of
+// TokenValue. Phases that walk the tokens in order only touch the arrays they
+// need, e.g. the types alone while matching a production. The values of number
+// tokens, converted once by the scanner, are kept in a side array with one
+// entry per number token, so that the other tokens pay nothing for them.
+// Copyright 2016 Hieu Le.
+
+#ifndef TRUPLC_TOKENS_TOKEN_STREAM_H__
+#define TRUPLC_TOKENS_TOKEN_STREAM_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "tokens/token.h"
+#include "tokens/token_value.h"
+
+namespace truplc {
+
+class TokenStream {
+ public:
+  // Returns the number of tokens in the stream.
+  size_t size() const { return types_.size(); }
+
+  // Checks if the stream holds no token.
+  bool empty() const { return types_.empty(); }
+
+  // Returns the type of the i-th token. Types are stored as single bytes,
+  // which hold every TokenType value.
+  TokenType type(const size_t i) const {
+    return static_cast<TokenType>(types_[i]);
+  }
+
+  // Returns the attribute of the i-th token. See TokenValue::attribute.
+  int attribute(const size_t i) const { return attributes_[i]; }
+
+  // Returns the offset of the lexeme of the i-th token from the start of the
+  // input.
+  uint32_t offset(const size_t i) const { return offsets_[i]; }
+
+  // Returns the number of characters in the lexeme of the i-th token.
+  uint32_t length(const size_t i) const { return lengths_[i]; }
+
+  // Returns the i-th token as a value.
+  TokenValue operator[](const size_t i) const {
+    return {type(i), attributes_[i], offsets_[i], lengths_[i]};
+  }
+
+  // Returns the value of the k-th number token of the stream, counting from
+  // zero. Consumers walking the tokens in order count the number tokens they
+  // pass to find k.
+  int64_t number(const size_t k) const { return numbers_[k]; }
+
+  // Returns the number of number tokens in the stream.
+  size_t number_count() const { return numbers_.size(); }
+
+  // Appends a token to the end of the stream. number is the value of a number
+  // token and is ignored for other tokens.
+  void push_back(const TokenValue& value, const int64_t number = 0) {
+    types_.push_back(static_cast<uint8_t>(value.type));
+    attributes_.push_back(value.attribute);
+    offsets_.push_back(value.offset);
+    lengths_.push_back(value.length);
+    if (value.type == TokenType::kNumber) {
+      numbers_.push_back(number);
+    }
+  }
+
+  // Reserves room for a given total number of tokens.
+  void reserve(const size_t size) {
+    types_.reserve(size);
+    attributes_.reserve(size);
+    offsets_.reserve(size);
+    lengths_.reserve(size);
+  }
+
+  // Removes all tokens, keeping the allocated storage for reuse.
+  void clear() {
+    types_.clear();
+    attributes_.clear();
+    offsets_.clear();
+    lengths_.clear();
+    numbers_.clear();
+  }
+
+ private:
+  // Fields of the tokens, indexed alike.
+  std::vector<uint8_t> types_;
+  std::vector<int> attributes_;
+  std::vector<uint32_t> offsets_;
+  std::vector<uint32_t> lengths_;
+
+  // Values of the number tokens, in order.
+  std::vector<int64_t> numbers_;
+};
+
+}  // namespace truplc
+
+#endif  // TRUPLC_TOKENS_TOKEN_STREAM_H__
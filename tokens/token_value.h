@@ -0,0 +1,47 @@
+// Compact value representation of a token. Unlike the Token class hierarchy,
+// a TokenValue is trivially copyable and is returned by value from the
+// scanner, without any heap allocation.
+// Copyright 2016 Hieu Le.
+
+#ifndef TRUPLC_TOKENS_TOKEN_VALUE_H__
+#define TRUPLC_TOKENS_TOKEN_VALUE_H__
+
+#include <cstdint>
+#include <type_traits>
+
+#include "tokens/token.h"
+
+namespace truplc {
+
+struct TokenValue {
+  // Category of the token.
+  TokenType type;
+
+  // Attribute of a keyword, punctuation or operator token, as the value of
+  // its attribute enum. For an identifier scanned with a StringInterner, the
+  // interned id of its name. Zero otherwise.
+  int attribute;
+
+  // Offset of the first character of the lexeme from the start of the input.
+  uint32_t offset;
+
+  // Number of characters in the lexeme. Zero for the EOF token.
+  uint32_t length;
+};
+
+static_assert(std::is_trivially_copyable<TokenValue>::value,
+              "TokenValue must be trivially copyable.");
+static_assert(sizeof(TokenValue) == 16, "TokenValue must stay compact.");
+
+inline bool operator==(const TokenValue& x, const TokenValue& y) {
+  return x.type == y.type && x.attribute == y.attribute
+      && x.offset == y.offset && x.length == y.length;
+}
+
+inline bool operator!=(const TokenValue& x, const TokenValue& y) {
+  return !(x == y);
+}
+
+}  // namespace truplc
+
+#endif  // TRUPLC_TOKENS_TOKEN_VALUE_H__
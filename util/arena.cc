@@ -0,0 +1,108 @@
+// Implementation for Arena class.
+// Copyright 2016 Hieu Le.
+
+#include "util/arena.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+namespace truplc {
+namespace {
+
+// Sizes of the first and largest regular blocks. Allocations larger than a
+// quarter of the largest block get a block of their own.
+const size_t kInitialBlockSize = 1 << 12;
+const size_t kMaxBlockSize = 1 << 20;
+
+}  // namespace
+
+Arena::Arena()
+    : blocks_(nullptr),
+      cursor_(nullptr),
+      limit_(nullptr),
+      next_block_size_(kInitialBlockSize),
+      cleanups_(nullptr),
+      bytes_used_(0),
+      bytes_reserved_(0) {}
+
+Arena::~Arena() {
+  Reset();
+}
+
+void Arena::Deallocate(void* /* p */, size_t /* size */,
+                       size_t /* alignment */) {}
+
+StringPiece Arena::CopyString(const StringPiece str) {
+  if (str.empty()) {
+    return StringPiece();
+  }
+  char* const copy = static_cast<char*>(Allocate(str.size(), 1));
+  std::memcpy(copy, str.data(), str.size());
+  return StringPiece(copy, str.size());
+}
+
+void Arena::Reset() {
+  for (Cleanup* cleanup = cleanups_; cleanup != nullptr;) {
+    Cleanup* const previous = cleanup->previous;
+    cleanup->destroy(cleanup->object);
+    cleanup = previous;
+  }
+  cleanups_ = nullptr;
+  while (blocks_ != nullptr) {
+    Block* const previous = blocks_->previous;
+    std::free(blocks_);
+    blocks_ = previous;
+  }
+  cursor_ = nullptr;
+  limit_ = nullptr;
+  next_block_size_ = kInitialBlockSize;
+  bytes_used_ = 0;
+  bytes_reserved_ = 0;
+}
+
+void Arena::AddCleanup(void* const object, void (*const destroy)(void*)) {
+  Cleanup* const cleanup =
+      static_cast<Cleanup*>(Allocate(sizeof(Cleanup), alignof(Cleanup)));
+  cleanup->destroy = destroy;
+  cleanup->object = object;
+  cleanup->previous = cleanups_;
+  cleanups_ = cleanup;
+}
+
+void* Arena::AllocateFromNewBlock(const size_t size, const size_t alignment) {
+  // The header is followed by enough room to align the allocation.
+  const size_t header = sizeof(Block) + alignment - 1;
+  const bool own_block = size > kMaxBlockSize / 4;
+  const size_t block_size =
+      own_block ? header + size : std::max(next_block_size_, header + size);
+  Block* const block = static_cast<Block*>(std::malloc(block_size));
+  if (block == nullptr) {
+    throw std::bad_alloc();
+  }
+  bytes_reserved_ += block_size;
+
+  char* const begin = reinterpret_cast<char*>(block + 1);
+  char* const end = reinterpret_cast<char*>(block) + block_size;
+  char* const start = reinterpret_cast<char*>(
+      (reinterpret_cast<uintptr_t>(begin) + alignment - 1) & ~(alignment - 1));
+  bytes_used_ += size;
+
+  if (own_block && blocks_ != nullptr) {
+    // A large allocation leaves the current block open by going behind it.
+    block->previous = blocks_->previous;
+    blocks_->previous = block;
+    return start;
+  }
+  block->previous = blocks_;
+  blocks_ = block;
+  cursor_ = start + size;
+  limit_ = end;
+  if (!own_block) {
+    next_block_size_ = std::min(2 * next_block_size_, kMaxBlockSize);
+  }
+  return start;
+}
+
+}  // namespace truplc
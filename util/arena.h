@@ -0,0 +1,132 @@
+// Monotonic arena allocator. Memory is carved sequentially out of growing
+// blocks and only released all at once, when the arena is reset or destroyed,
+// so that objects with a common lifetime, such as the tokens of a compilation,
+// cost no individual malloc or free calls.
+// Copyright 2016 Hieu Le.
+
+#ifndef TRUPLC_UTIL_ARENA_H__
+#define TRUPLC_UTIL_ARENA_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "util/string_piece.h"
+
+namespace truplc {
+
+// Source of raw memory, in the style of std::pmr::memory_resource.
+class MemoryResource {
+ public:
+  virtual ~MemoryResource() {}
+
+  // Returns size bytes aligned to a given power of two.
+  virtual void* Allocate(size_t size,
+                         size_t alignment = alignof(std::max_align_t)) = 0;
+
+  // Returns memory obtained from Allocate() with the same size and alignment.
+  virtual void Deallocate(void* p, size_t size,
+                          size_t alignment = alignof(std::max_align_t)) = 0;
+};
+
+class Arena : public MemoryResource {
+ public:
+  // Constructs an empty arena. No memory is allocated until first needed.
+  Arena();
+
+  ~Arena() override;
+
+  Arena(const Arena&) = delete;
+  Arena& operator=(const Arena&) = delete;
+
+  // Returns size bytes aligned to a given power of two, valid until the arena
+  // is reset or destroyed.
+  void* Allocate(size_t size,
+                 size_t alignment = alignof(std::max_align_t)) final {
+    const uintptr_t start =
+        (reinterpret_cast<uintptr_t>(cursor_) + alignment - 1) &
+        ~(alignment - 1);
+    if (start + size > reinterpret_cast<uintptr_t>(limit_)) {
+      return AllocateFromNewBlock(size, alignment);
+    }
+    cursor_ = reinterpret_cast<char*>(start + size);
+    bytes_used_ += size;
+    return reinterpret_cast<void*>(start);
+  }
+
+  // Does nothing: memory is only released by Reset() or the destructor.
+  void Deallocate(void* p, size_t size,
+                  size_t alignment = alignof(std::max_align_t)) final;
+
+  // Constructs an object of type T in the arena from given arguments. Its
+  // destructor, unless trivial, runs when the arena is reset or destroyed.
+  template <typename T, typename... Args>
+  T* New(Args&&... args) {
+    void* const memory = Allocate(sizeof(T), alignof(T));
+    T* const object = new (memory) T(std::forward<Args>(args)...);
+    if (!std::is_trivially_destructible<T>::value) {
+      AddCleanup(object, &Destroy<T>);
+    }
+    return object;
+  }
+
+  // Copies the characters of a string into the arena and returns the copy.
+  StringPiece CopyString(StringPiece str);
+
+  // Destroys the objects constructed in the arena, in reverse order of
+  // construction, and frees all its memory.
+  void Reset();
+
+  // Returns the number of bytes handed out since the last reset.
+  size_t bytes_used() const { return bytes_used_; }
+
+  // Returns the number of bytes held in blocks, including unused space.
+  size_t bytes_reserved() const { return bytes_reserved_; }
+
+ private:
+  // Header at the start of each block, linking it to the previous block.
+  struct Block {
+    Block* previous;
+  };
+
+  // Destructor to run on an object when the arena is reset.
+  struct Cleanup {
+    void (*destroy)(void*);
+    void* object;
+    Cleanup* previous;
+  };
+
+  // Runs the destructor of an object of type T.
+  template <typename T>
+  static void Destroy(void* object) {
+    static_cast<T*>(object)->~T();
+  }
+
+  // Records a destructor to run on an object when the arena is reset.
+  void AddCleanup(void* object, void (*destroy)(void*));
+
+  // Allocates size bytes aligned to alignment from a new block.
+  void* AllocateFromNewBlock(size_t size, size_t alignment);
+
+  // Most recent block, or null if none has been allocated.
+  Block* blocks_;
+
+  // Free space at the end of the block being carved.
+  char* cursor_;
+  char* limit_;
+
+  // Size of the next regular block. Doubles with every block up to a limit.
+  size_t next_block_size_;
+
+  // Most recently recorded destructor, or null.
+  Cleanup* cleanups_;
+
+  size_t bytes_used_;
+  size_t bytes_reserved_;
+};
+
+}  // namespace truplc
+
+#endif  // TRUPLC_UTIL_ARENA_H__
@@ -0,0 +1,95 @@
+// Implementation for BufferedWriter class.
+// Copyright 2016 Hieu Le.
+
+#include "util/buffered_writer.h"
+
+#include <errno.h>
+#include <unistd.h>
+
+namespace truplc {
+
+const size_t BufferedWriter::kDefaultCapacity;
+
+BufferedWriter::BufferedWriter(const int fd, const size_t capacity)
+    : fd_(fd),
+      buffer_(new char[capacity]),
+      capacity_(capacity),
+      failed_(false) {
+  setp(buffer_.get(), buffer_.get() + capacity_);
+}
+
+BufferedWriter::~BufferedWriter() {
+  Flush();
+}
+
+void BufferedWriter::AppendDecimal(const int64_t value) {
+  // Digits are produced backwards into a scratch buffer large enough for the
+  // most negative value.
+  char digits[20];
+  char* p = digits + sizeof(digits);
+  uint64_t magnitude = value < 0 ? 0 - static_cast<uint64_t>(value)
+                                 : static_cast<uint64_t>(value);
+  do {
+    *--p = static_cast<char>('0' + magnitude % 10);
+    magnitude /= 10;
+  } while (magnitude != 0);
+  if (value < 0) {
+    *--p = '-';
+  }
+  Append(p, digits + sizeof(digits) - p);
+}
+
+bool BufferedWriter::Flush() {
+  const size_t size = pptr() - pbase();
+  setp(buffer_.get(), buffer_.get() + capacity_);
+  return WriteFully(buffer_.get(), size) && !failed_;
+}
+
+void BufferedWriter::AppendSlow(const char* const data, const size_t size) {
+  Flush();
+  // Large blocks skip the buffer altogether.
+  if (size >= capacity_) {
+    WriteFully(data, size);
+    return;
+  }
+  std::memcpy(pptr(), data, size);
+  pbump(static_cast<int>(size));
+}
+
+bool BufferedWriter::WriteFully(const char* data, size_t size) {
+  while (size != 0) {
+    const ssize_t written = write(fd_, data, size);
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      failed_ = true;
+      return false;
+    }
+    data += written;
+    size -= static_cast<size_t>(written);
+  }
+  return true;
+}
+
+BufferedWriter::int_type BufferedWriter::overflow(const int_type c) {
+  if (!Flush()) {
+    return traits_type::eof();
+  }
+  if (!traits_type::eq_int_type(c, traits_type::eof())) {
+    Append(traits_type::to_char_type(c));
+  }
+  return traits_type::not_eof(c);
+}
+
+int BufferedWriter::sync() {
+  return Flush() ? 0 : -1;
+}
+
+std::streamsize BufferedWriter::xsputn(const char* const s,
+                                       const std::streamsize n) {
+  Append(s, static_cast<size_t>(n));
+  return n;
+}
+
+}  // namespace truplc
@@ -0,0 +1,101 @@
+// Output buffer that writes to a file descriptor in large blocks. It is also a
+// std::streambuf, so that it can back std::cout: anything written to
+// std::cerr, which is tied to std::cout, flushes the buffer first and stays
+// in order with the buffered output. As a Sink, it receives the debug strings
+// of tokens without temporary strings.
+// Copyright 2016 Hieu Le.
+
+#ifndef TRUPLC_UTIL_BUFFERED_WRITER_H__
+#define TRUPLC_UTIL_BUFFERED_WRITER_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <streambuf>
+
+#include "util/sink.h"
+#include "util/string_piece.h"
+
+namespace truplc {
+
+class BufferedWriter : public std::streambuf, public Sink {
+ public:
+  // Default number of bytes buffered between writes.
+  static const size_t kDefaultCapacity = 1 << 16;
+
+  // Constructs a writer to a given file descriptor, which is not closed by
+  // the writer.
+  explicit BufferedWriter(int fd, size_t capacity = kDefaultCapacity);
+
+  // Flushes any buffered output.
+  ~BufferedWriter() override;
+
+  BufferedWriter(const BufferedWriter&) = delete;
+  BufferedWriter& operator=(const BufferedWriter&) = delete;
+
+  // Appends a character.
+  void Append(const char c) {
+    if (pptr() == epptr()) {
+      Flush();
+    }
+    *pptr() = c;
+    pbump(1);
+  }
+
+  // Appends size bytes starting at data. Final, so that appends through a
+  // BufferedWriter are bound statically.
+  void Append(const char* const data, const size_t size) final {
+    if (size <= static_cast<size_t>(epptr() - pptr())) {
+      std::memcpy(pptr(), data, size);
+      pbump(static_cast<int>(size));
+    } else {
+      AppendSlow(data, size);
+    }
+  }
+
+  // Appends the characters of a string.
+  void Append(const StringPiece str) { Append(str.data(), str.size()); }
+
+  // Appends the characters of a null-terminated string.
+  void Append(const char* const str) { Append(str, std::strlen(str)); }
+
+  // Appends the decimal digits of a number, without allocating.
+  void AppendDecimal(int64_t value);
+
+  // Writes all buffered output to the file descriptor. Returns false if this
+  // or any earlier write has failed, including those made while appending.
+  bool Flush();
+
+ protected:
+  // Flushes a full buffer and then buffers c, for std::ostream.
+  int_type overflow(int_type c) override;
+
+  // Flushes the buffer, for std::ostream::flush().
+  int sync() override;
+
+  // Appends n characters, for std::ostream::write().
+  std::streamsize xsputn(const char* s, std::streamsize n) override;
+
+ private:
+  // Appends bytes that do not fit in the free space of the buffer.
+  void AppendSlow(const char* data, size_t size);
+
+  // Writes size bytes starting at data to the file descriptor. Returns false,
+  // and remembers the failure, if a write fails.
+  bool WriteFully(const char* data, size_t size);
+
+  // The file descriptor output is written to.
+  const int fd_;
+
+  // The buffer, used as the put area of the stream buffer.
+  const std::unique_ptr<char[]> buffer_;
+  const size_t capacity_;
+
+  // Whether any write to the file descriptor has failed.
+  bool failed_;
+};
+
+}  // namespace truplc
+
+#endif  // TRUPLC_UTIL_BUFFERED_WRITER_H__
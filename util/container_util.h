@@ -5,6 +5,7 @@
 #define TRUPLC_UTIL_CONTAINER_UTIL_H__
 
 #include <algorithm>
+#include <iterator>
 
 namespace truplc {
 
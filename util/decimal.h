@@ -0,0 +1,91 @@
+// Conversion of decimal digit strings into integers. Digits are converted
+// eight at a time with SWAR (SIMD within a register) arithmetic on little-
+// endian machines, one at a time elsewhere. Header-only so that the scanner
+// inlines it into its scanning loop.
+// Copyright 2016 Hieu Le.
+
+#ifndef TRUPLC_UTIL_DECIMAL_H__
+#define TRUPLC_UTIL_DECIMAL_H__
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+#include "util/string_piece.h"
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define TRUPLC_SWAR_DECIMAL 1
+#endif
+
+namespace truplc {
+
+namespace internal {
+
+#ifdef TRUPLC_SWAR_DECIMAL
+// Checks if the eight bytes of a word are all ASCII digits. The lowest byte
+// that is not a digit sets its high bit either when '0' is subtracted from it
+// or when 0x46 is added to it; digits set neither.
+inline bool AreEightDigits(const uint64_t word) {
+  return (((word + 0x4646464646464646u) | (word - 0x3030303030303030u)) &
+          0x8080808080808080u) == 0;
+}
+
+// Returns the value of eight ASCII digits loaded into a word, the first digit
+// in the lowest byte. Adjacent digits are combined into pairs, pairs into
+// quadruples and quadruples into the result, with one multiplication each.
+inline uint64_t ParseEightDigits(uint64_t word) {
+  word -= 0x3030303030303030u;
+  word = (word * 10) + (word >> 8);
+  word = (((word & 0x000000FF000000FFu) * (100 + (1000000ull << 32))) +
+          (((word >> 16) & 0x000000FF000000FFu) * (1 + (10000ull << 32)))) >>
+         32;
+  return word & 0xFFFFFFFFu;
+}
+#endif
+
+}  // namespace internal
+
+// Converts a string of decimal digits into its value, stored into *value.
+// Returns false, leaving *value unchanged, if digits is empty, holds anything
+// but the digits 0 to 9, or stands for a value greater than INT64_MAX.
+inline bool ParseDecimal(const StringPiece digits, int64_t* const value) {
+  const uint64_t kMaxValue = std::numeric_limits<int64_t>::max();
+  if (digits.empty()) {
+    return false;
+  }
+  const char* p = digits.data();
+  const char* const end = p + digits.size();
+  uint64_t result = 0;
+
+#ifdef TRUPLC_SWAR_DECIMAL
+  for (; end - p >= 8; p += 8) {
+    uint64_t word;
+    std::memcpy(&word, p, sizeof(word));
+    if (!internal::AreEightDigits(word)) {
+      return false;
+    }
+    const uint64_t chunk = internal::ParseEightDigits(word);
+    if (result > (kMaxValue - chunk) / 100000000) {
+      return false;
+    }
+    result = result * 100000000 + chunk;
+  }
+#endif
+
+  for (; p != end; ++p) {
+    if (*p < '0' || *p > '9') {
+      return false;
+    }
+    const uint64_t digit = *p - '0';
+    if (result > (kMaxValue - digit) / 10) {
+      return false;
+    }
+    result = result * 10 + digit;
+  }
+  *value = static_cast<int64_t>(result);
+  return true;
+}
+
+}  // namespace truplc
+
+#endif  // TRUPLC_UTIL_DECIMAL_H__
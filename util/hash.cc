@@ -0,0 +1,51 @@
+// Implementation for hashing functions. Hash64() follows MurmurHash64A by
+// Austin Appleby, which is in the public domain.
+// Copyright 2016 Hieu Le.
+
+#include "util/hash.h"
+
+#include <cstring>
+
+namespace truplc {
+namespace {
+
+// Multiplier and shift of the mixing steps.
+const uint64_t kMul = 0xc6a4a7935bd1e995ULL;
+const int kShift = 47;
+
+}  // namespace
+
+uint64_t Hash64(const char* const data, const size_t size,
+                const uint64_t seed) {
+  uint64_t hash = seed ^ (size * kMul);
+
+  const char* p = data;
+  const char* const words_end = data + (size & ~size_t{7});
+  for (; p != words_end; p += 8) {
+    uint64_t word;
+    std::memcpy(&word, p, sizeof(word));
+    word *= kMul;
+    word ^= word >> kShift;
+    word *= kMul;
+    hash ^= word;
+    hash *= kMul;
+  }
+
+  // Fold in the last size % 8 bytes.
+  const size_t tail = size & 7;
+  if (tail != 0) {
+    uint64_t word = 0;
+    for (size_t i = tail; i-- > 0;) {
+      word = (word << 8) | static_cast<unsigned char>(p[i]);
+    }
+    hash ^= word;
+    hash *= kMul;
+  }
+
+  hash ^= hash >> kShift;
+  hash *= kMul;
+  hash ^= hash >> kShift;
+  return hash;
+}
+
+}  // namespace truplc
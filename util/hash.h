@@ -0,0 +1,20 @@
+// Fast non-cryptographic hashing of byte strings.
+// Copyright 2016 Hieu Le.
+
+#ifndef TRUPLC_UTIL_HASH_H__
+#define TRUPLC_UTIL_HASH_H__
+
+#include <cstddef>
+#include <cstdint>
+
+namespace truplc {
+
+// Returns a 64-bit hash of size bytes starting at data. Bytes are consumed
+// eight at a time, so that whole source files hash at memory speed. The
+// result is stable across runs and platforms of the same byte order, and is
+// suited to keying caches but not to resisting deliberate collisions.
+uint64_t Hash64(const char* data, size_t size, uint64_t seed = 0);
+
+}  // namespace truplc
+
+#endif  // TRUPLC_UTIL_HASH_H__
@@ -0,0 +1,65 @@
+// Implementation of MappedFile.
+// Copyright 2016 Hieu Le.
+
+#include "util/mapped_file.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace truplc {
+
+MappedFile::MappedFile() : data_(nullptr), size_(0) {}
+
+MappedFile::~MappedFile() {
+  Close();
+}
+
+bool MappedFile::Open(const std::string& filename) {
+  Close();
+
+  const int fd = open(filename.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+
+  struct stat info;
+  if (fstat(fd, &info) != 0) {
+    close(fd);
+    return false;
+  }
+
+  // mmap() rejects zero-length mappings, so an empty file maps to nothing.
+  if (info.st_size > 0) {
+    void* region = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ,
+                        MAP_PRIVATE, fd, 0);
+    if (region == MAP_FAILED) {
+      close(fd);
+      return false;
+    }
+    // The source is read front to back exactly once.
+    madvise(region, static_cast<size_t>(info.st_size), MADV_SEQUENTIAL);
+    data_ = static_cast<const char*>(region);
+    size_ = static_cast<size_t>(info.st_size);
+  }
+
+  // The mapping stays valid after the descriptor is closed.
+  close(fd);
+  return true;
+}
+
+void MappedFile::Close() {
+  if (data_ != nullptr) {
+    munmap(const_cast<char*>(data_), size_);
+  }
+  data_ = nullptr;
+  size_ = 0;
+}
+
+bool IsRegularFile(const std::string& filename) {
+  struct stat info;
+  return stat(filename.c_str(), &info) == 0 && S_ISREG(info.st_mode);
+}
+
+}  // namespace truplc
@@ -0,0 +1,52 @@
+// Read-only memory mapping of a whole file.
+// Copyright 2016 Hieu Le.
+
+#ifndef TRUPLC_UTIL_MAPPED_FILE_H__
+#define TRUPLC_UTIL_MAPPED_FILE_H__
+
+#include <cstddef>
+#include <string>
+
+namespace truplc {
+
+class MappedFile {
+ public:
+  // Constructs an empty mapping. Call Open() to map a file.
+  MappedFile();
+
+  // Unmaps the file if one is mapped.
+  ~MappedFile();
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  // Maps the whole content of a file into memory for reading. Any previously
+  // mapped file is released first. Returns true on success; false if the file
+  // cannot be opened or mapped.
+  bool Open(const std::string& filename);
+
+  // Releases the current mapping, if any.
+  void Close();
+
+  // Returns the first byte of the mapped content. The returned pointer may be
+  // null when the file is empty.
+  const char* data() const { return data_; }
+
+  // Returns the number of mapped bytes.
+  size_t size() const { return size_; }
+
+ private:
+  // Start of the mapped region.
+  const char* data_;
+
+  // Length of the mapped region.
+  size_t size_;
+};
+
+// Checks if a given path names a regular file, which can be memory-mapped.
+// Pipes, character devices and missing files all yield false.
+bool IsRegularFile(const std::string& filename);
+
+}  // namespace truplc
+
+#endif  // TRUPLC_UTIL_MAPPED_FILE_H__
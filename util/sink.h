@@ -0,0 +1,51 @@
+// Destination of appended text, such as a growable string or an output
+// buffer. Text is formatted straight into its final storage instead of being
+// returned as temporary strings.
+// Copyright 2016 Hieu Le.
+
+#ifndef TRUPLC_UTIL_SINK_H__
+#define TRUPLC_UTIL_SINK_H__
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+
+#include "util/string_piece.h"
+
+namespace truplc {
+
+class Sink {
+ public:
+  virtual ~Sink() {}
+
+  // Appends size bytes starting at data.
+  virtual void Append(const char* data, size_t size) = 0;
+
+  // Appends the characters of a string.
+  void Append(const StringPiece str) { Append(str.data(), str.size()); }
+
+  // Appends the characters of a null-terminated string.
+  void Append(const char* const str) { Append(str, std::strlen(str)); }
+};
+
+// Sink appending to a string, which grows as needed.
+class StringSink : public Sink {
+ public:
+  // Constructs a sink appending to a given string, which must outlive the
+  // sink.
+  explicit StringSink(std::string* const out) : out_(out) {}
+
+  using Sink::Append;
+
+  void Append(const char* const data, const size_t size) override {
+    out_->append(data, size);
+  }
+
+ private:
+  // The string appended to.
+  std::string* const out_;
+};
+
+}  // namespace truplc
+
+#endif  // TRUPLC_UTIL_SINK_H__
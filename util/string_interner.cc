@@ -0,0 +1,83 @@
+// Implementation for StringInterner class.
+// Copyright 2016 Hieu Le.
+
+#include "util/string_interner.h"
+
+namespace truplc {
+namespace {
+
+// Initial number of hash table slots.
+const size_t kInitialSlots = 64;
+
+// Returns the 32-bit FNV-1a hash of a string.
+uint32_t Hash(const StringPiece str) {
+  uint32_t hash = 2166136261u;
+  for (const char c : str) {
+    hash = (hash ^ static_cast<unsigned char>(c)) * 16777619u;
+  }
+  return hash;
+}
+
+}  // namespace
+
+const StringInterner::Id StringInterner::kNoId;
+
+StringInterner::StringInterner()
+    : slots_(kInitialSlots, kNoId) {}
+
+StringInterner::~StringInterner() {}
+
+StringInterner::Id StringInterner::Intern(const StringPiece str) {
+  const uint32_t hash = Hash(str);
+  size_t slot = FindSlot(str, hash);
+  if (slots_[slot] != kNoId) {
+    return slots_[slot];
+  }
+
+  const Id id = static_cast<Id>(strings_.size());
+  strings_.push_back(arena_.CopyString(str));
+  hashes_.push_back(hash);
+  if (2 * strings_.size() > slots_.size()) {
+    Grow();
+    slot = FindSlot(str, hash);
+  }
+  slots_[slot] = id;
+  return id;
+}
+
+StringInterner::Id StringInterner::Find(const StringPiece str) const {
+  return slots_[FindSlot(str, Hash(str))];
+}
+
+void StringInterner::Clear() {
+  arena_.Reset();
+  strings_.clear();
+  hashes_.clear();
+  slots_.assign(kInitialSlots, kNoId);
+}
+
+size_t StringInterner::FindSlot(const StringPiece str,
+                                const uint32_t hash) const {
+  const size_t mask = slots_.size() - 1;
+  for (size_t slot = hash & mask;; slot = (slot + 1) & mask) {
+    const Id id = slots_[slot];
+    if (id == kNoId || (hashes_[id] == hash && strings_[id] == str)) {
+      return slot;
+    }
+  }
+}
+
+void StringInterner::Grow() {
+  std::vector<Id> slots(2 * slots_.size(), kNoId);
+  const size_t mask = slots.size() - 1;
+  for (Id id = 0; id < strings_.size(); ++id) {
+    size_t slot = hashes_[id] & mask;
+    while (slots[slot] != kNoId) {
+      slot = (slot + 1) & mask;
+    }
+    slots[slot] = id;
+  }
+  slots_.swap(slots);
+}
+
+}  // namespace truplc
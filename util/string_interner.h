@@ -0,0 +1,77 @@
+// String interning pool. Each distinct spelling is copied once into
+// arena-backed storage and mapped to a stable 32-bit id, so that names can be
+// compared as integers and repeated names cost no extra memory.
+// Copyright 2016 Hieu Le.
+
+#ifndef TRUPLC_UTIL_STRING_INTERNER_H__
+#define TRUPLC_UTIL_STRING_INTERNER_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "util/arena.h"
+#include "util/string_piece.h"
+
+namespace truplc {
+
+class StringInterner {
+ public:
+  // Identifier of an interned string. Ids are assigned densely from zero, in
+  // the order in which strings are first interned.
+  typedef uint32_t Id;
+
+  // Id that no interned string ever receives.
+  static const Id kNoId = 0xFFFFFFFF;
+
+  // Constructs an empty pool.
+  StringInterner();
+
+  ~StringInterner();
+
+  StringInterner(const StringInterner&) = delete;
+  StringInterner& operator=(const StringInterner&) = delete;
+
+  // Returns the id of a string, copying the string into the pool first if it
+  // has not been interned yet.
+  Id Intern(StringPiece str);
+
+  // Returns the id of a string if it has been interned; kNoId otherwise.
+  Id Find(StringPiece str) const;
+
+  // Returns the string interned under a given id. The characters remain valid
+  // and unchanged for the lifetime of the pool.
+  StringPiece Lookup(const Id id) const { return strings_[id]; }
+
+  // Returns the number of distinct strings in the pool.
+  size_t size() const { return strings_.size(); }
+
+  // Removes every string from the pool, which invalidates all ids and the
+  // characters returned by Lookup().
+  void Clear();
+
+ private:
+  // Returns the index of the slot that holds the id of a string with a given
+  // hash, or of the empty slot where that id belongs.
+  size_t FindSlot(StringPiece str, uint32_t hash) const;
+
+  // Doubles the number of slots and reinserts every id.
+  void Grow();
+
+  // Holds the characters of all interned strings, which are never moved or
+  // freed before the pool itself.
+  Arena arena_;
+
+  // Interned strings and their hashes, indexed by id.
+  std::vector<StringPiece> strings_;
+  std::vector<uint32_t> hashes_;
+
+  // Open-addressed hash table of ids, probed linearly. Empty slots hold kNoId.
+  // The number of slots is a power of two and at least twice the number of
+  // strings.
+  std::vector<Id> slots_;
+};
+
+}  // namespace truplc
+
+#endif  // TRUPLC_UTIL_STRING_INTERNER_H__
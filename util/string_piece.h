@@ -0,0 +1,72 @@
+// Non-owning reference to a contiguous sequence of characters.
+// Copyright 2016 Hieu Le.
+
+#ifndef TRUPLC_UTIL_STRING_PIECE_H__
+#define TRUPLC_UTIL_STRING_PIECE_H__
+
+#include <cstddef>
+#include <cstring>
+#include <ostream>
+#include <string>
+
+namespace truplc {
+
+class StringPiece {
+ public:
+  // Constructs an empty piece.
+  constexpr StringPiece() : data_(nullptr), size_(0) {}
+
+  // Constructs a piece referring to size characters starting at data.
+  constexpr StringPiece(const char* data, size_t size)
+      : data_(data), size_(size) {}
+
+  // Constructs a piece referring to the content of a string. The string must
+  // outlive the piece and must not be modified while the piece is in use.
+  StringPiece(const std::string& str)  // NOLINT(runtime/explicit)
+      : data_(str.data()), size_(str.size()) {}
+
+  // Returns the first referenced character. May be null for an empty piece.
+  constexpr const char* data() const { return data_; }
+
+  // Returns the number of referenced characters.
+  constexpr size_t size() const { return size_; }
+
+  // Checks if the piece refers to no character.
+  constexpr bool empty() const { return size_ == 0; }
+
+  // Iterators over the referenced characters.
+  constexpr const char* begin() const { return data_; }
+  constexpr const char* end() const { return data_ + size_; }
+
+  // Returns the character at a given position, which must be less than size().
+  constexpr char operator[](const size_t i) const { return data_[i]; }
+
+  // Returns an owning copy of the referenced characters.
+  std::string ToString() const {
+    return empty() ? std::string() : std::string(data_, size_);
+  }
+
+ private:
+  // First referenced character.
+  const char* data_;
+
+  // Number of referenced characters.
+  size_t size_;
+};
+
+inline bool operator==(const StringPiece x, const StringPiece y) {
+  return x.size() == y.size()
+      && (x.empty() || std::memcmp(x.data(), y.data(), x.size()) == 0);
+}
+
+inline bool operator!=(const StringPiece x, const StringPiece y) {
+  return !(x == y);
+}
+
+inline std::ostream& operator<<(std::ostream& out, const StringPiece piece) {
+  return out.write(piece.data(), piece.size());
+}
+
+}  // namespace truplc
+
+#endif  // TRUPLC_UTIL_STRING_PIECE_H__
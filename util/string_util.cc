@@ -4,6 +4,7 @@
 #include "util/string_util.h"
 
 #include <cstdarg>
+#include <cstring>
 
 #include <initializer_list>
 #include <memory>
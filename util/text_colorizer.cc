@@ -18,6 +18,18 @@ std::ostream& TextColorizer::Print(std::ostream& os,
             << static_cast<int>(kFGDefaultColorizer.color_) << "m";
 }
 
+void TextColorizer::AppendColor(Sink* const sink) const {
+  // Every color code has two digits.
+  const int code = static_cast<int>(color_);
+  const char sequence[] = {'\033', '[', static_cast<char>('0' + code / 10),
+                           static_cast<char>('0' + code % 10), 'm'};
+  sink->Append(sequence, sizeof(sequence));
+}
+
+void TextColorizer::AppendReset(Sink* const sink) {
+  kFGDefaultColorizer.AppendColor(sink);
+}
+
 TextColorizer::TextColorizer(const TextColor color) : color_(color) {}
 
 }  // namespace truplc
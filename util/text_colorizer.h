@@ -7,6 +7,8 @@
 #include <ostream>
 #include <string>
 
+#include "util/sink.h"
+
 namespace truplc {
 
 class TextColorizer {
@@ -21,6 +23,14 @@ class TextColorizer {
   static std::ostream& Print(std::ostream& os, const TextColorizer& colorizer,
                              const std::string& output);
 
+  // Appends the escape sequence that switches to the color of this colorizer
+  // to a sink, without allocating. Text appended next is colored until
+  // AppendReset() is called.
+  void AppendColor(Sink* sink) const;
+
+  // Appends the escape sequence that restores the default color to a sink.
+  static void AppendReset(Sink* sink);
+
  private:
   // Color options to prettify output to UNIX terminal.
   enum class TextColor : int {